@@ -0,0 +1,138 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_ADAPTIVE_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_ADAPTIVE_STACK_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iosfwd>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/label_stack.hpp>
+#include <boost/coroutine/painted_stack_allocator.hpp>
+#include <boost/coroutine/stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// sizes stacks by the deepest stack usage recorded for the coroutine-function
+// (its type or the label passed to the constructor) plus a safety margin
+// - the stack usage is measured like painted_stack_allocator does
+// - if nothing was recorded yet the requested size is used
+template< typename StackAllocator = stack_allocator >
+class adaptive_stack_allocator
+{
+private:
+    template< typename X >
+    friend void assign_site( adaptive_stack_allocator< X > &, char const*, void const*);
+
+    template< typename X >
+    friend bool labels_stacks( adaptive_stack_allocator< X > const&);
+
+    template< typename X >
+    friend bool needs_signal_stack( adaptive_stack_allocator< X > const&);
+
+    StackAllocator      alloc_;
+    char const      *   site_;
+    std::size_t         margin_;
+    bool                learn_;
+
+public:
+    static bool is_stack_unbound()
+    { return StackAllocator::is_stack_unbound(); }
+
+    static std::size_t default_stacksize()
+    { return StackAllocator::default_stacksize(); }
+
+    static std::size_t minimum_stacksize()
+    { return StackAllocator::minimum_stacksize(); }
+
+    static std::size_t maximum_stacksize()
+    { return StackAllocator::maximum_stacksize(); }
+
+    // writes the recorded stack usage of all coroutine-functions
+    static void save( std::ostream & os)
+    { detail::painted_stack_save( os); }
+
+    // merges stack usage previously written by save()
+    static void load( std::istream & is)
+    { detail::painted_stack_load( is); }
+
+    // margin: added to the recorded stack usage, in percent
+    // learn: measure the stack usage (paints the stacks)
+    explicit adaptive_stack_allocator( char const* site = "",
+                                       std::size_t margin = 50,
+                                       bool learn = true,
+                                       StackAllocator const& alloc = StackAllocator() ) :
+        alloc_( alloc), site_( site), margin_( margin), learn_( learn)
+    {}
+
+    char const* site() const
+    { return site_; }
+
+    // call site the stacks of the coroutine-function `fn` are accounted to
+    // if no label was given
+    template< typename Fn >
+    static char const* site( Fn const& fn)
+    { return detail::function_site( fn); }
+
+    // size of the stack allocate() would create instead of `size`
+    std::size_t stacksize( std::size_t size) const
+    {
+        const std::size_t peak( detail::painted_stack_peak( site_) );
+        if ( 0 == peak) return size;
+        return ( std::min)( size,
+                ( std::max)( minimum_stacksize(), peak + peak / 100 * margin_) );
+    }
+
+    void allocate( stack_context & ctx, std::size_t size)
+    {
+        alloc_.allocate( ctx, stacksize( size) );
+        if ( learn_) detail::paint_stack( ctx, site_);
+    }
+
+    void deallocate( stack_context & ctx)
+    {
+        if ( learn_) detail::unpaint_stack( ctx);
+        alloc_.deallocate( ctx);
+    }
+};
+
+template< typename StackAllocator >
+void assign_site( adaptive_stack_allocator< StackAllocator > & alloc, char const* site, void const* fn)
+{ if ( '\0' == * alloc.site_) alloc.site_ = detail::function_site( site, fn); }
+
+template< typename StackAllocator >
+bool labels_stacks( adaptive_stack_allocator< StackAllocator > const& alloc)
+{
+    using detail::labels_stacks;
+    return labels_stacks( alloc.alloc_);
+}
+
+template< typename StackAllocator >
+bool needs_signal_stack( adaptive_stack_allocator< StackAllocator > const& alloc)
+{
+    using detail::needs_signal_stack;
+    return needs_signal_stack( alloc.alloc_);
+}
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_ADAPTIVE_STACK_ALLOCATOR_H
@@ -7,10 +7,17 @@
 #ifndef BOOST_COROUTINES_ALL_H
 #define BOOST_COROUTINES_ALL_H
 
+#include <boost/coroutine/adaptive_stack_allocator.hpp>
 #include <boost/coroutine/attributes.hpp>
 #include <boost/coroutine/coroutine.hpp>
 #include <boost/coroutine/exceptions.hpp>
 #include <boost/coroutine/flags.hpp>
+#include <boost/coroutine/memory_budget.hpp>
+#include <boost/coroutine/numa_allocator.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
+#include <boost/coroutine/painted_stack_allocator.hpp>
 #include <boost/coroutine/stack_allocator.hpp>
+#include <boost/coroutine/stack_statistics.hpp>
+#include <boost/coroutine/static_stack_pool.hpp>
 
 #endif // BOOST_COROUTINES_ALL_H
@@ -26,29 +26,62 @@ struct attributes
     std::size_t     size;
     flag_unwind_t   do_unwind;
     flag_fpu_t      preserve_fpu;
+    // stack_shared (POSIX): resumed and destroyed only by the creating thread,
+    // not while another coroutine on a shared stack runs; resuming throws
+    // std::bad_alloc if the stack of the suspended occupant can not be saved
+    flag_stack_t    share_stack;
+    flag_prefault_t prefault;
+    flag_color_t    color_stack;
+    flag_budget_t   budget;         // exceeding memory_budget throws or waits (POSIX)
+    flag_control_t  control;        // control block on top of the stack (POSIX)
+    char const  *   label;          // names the stack mapping (POSIX)
 
     attributes() BOOST_NOEXCEPT :
         size( stack_allocator::default_stacksize() ),
         do_unwind( stack_unwind),
-        preserve_fpu( fpu_preserved)
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes( std::size_t size_) BOOST_NOEXCEPT :
         size( size_),
         do_unwind( stack_unwind),
-        preserve_fpu( fpu_preserved)
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes( flag_unwind_t do_unwind_) BOOST_NOEXCEPT :
         size( stack_allocator::default_stacksize() ),
         do_unwind( do_unwind_),
-        preserve_fpu( fpu_preserved)
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes( flag_fpu_t preserve_fpu_) BOOST_NOEXCEPT :
         size( stack_allocator::default_stacksize() ),
         do_unwind( stack_unwind),
-        preserve_fpu( preserve_fpu_)
+        preserve_fpu( preserve_fpu_),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes(
@@ -56,7 +89,13 @@ struct attributes
             flag_unwind_t do_unwind_) BOOST_NOEXCEPT :
         size( size_),
         do_unwind( do_unwind_),
-        preserve_fpu( fpu_preserved)
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes(
@@ -64,7 +103,13 @@ struct attributes
             flag_fpu_t preserve_fpu_) BOOST_NOEXCEPT :
         size( size_),
         do_unwind( stack_unwind),
-        preserve_fpu( preserve_fpu_)
+        preserve_fpu( preserve_fpu_),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
     {}
 
     explicit attributes(
@@ -72,7 +117,143 @@ struct attributes
             flag_fpu_t preserve_fpu_) BOOST_NOEXCEPT :
         size( stack_allocator::default_stacksize() ),
         do_unwind( do_unwind_),
-        preserve_fpu( preserve_fpu_)
+        preserve_fpu( preserve_fpu_),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes( flag_stack_t share_stack_) BOOST_NOEXCEPT :
+        size( stack_allocator::default_stacksize() ),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( share_stack_),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes(
+            std::size_t size_,
+            flag_stack_t share_stack_) BOOST_NOEXCEPT :
+        size( size_),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( share_stack_),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes( flag_prefault_t prefault_) BOOST_NOEXCEPT :
+        size( stack_allocator::default_stacksize() ),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( prefault_),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes(
+            std::size_t size_,
+            flag_prefault_t prefault_) BOOST_NOEXCEPT :
+        size( size_),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( prefault_),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes( flag_color_t color_stack_) BOOST_NOEXCEPT :
+        size( stack_allocator::default_stacksize() ),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( color_stack_),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes(
+            std::size_t size_,
+            flag_color_t color_stack_) BOOST_NOEXCEPT :
+        size( size_),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( color_stack_),
+        budget( budget_fail),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes( flag_budget_t budget_) BOOST_NOEXCEPT :
+        size( stack_allocator::default_stacksize() ),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes(
+            std::size_t size_,
+            flag_budget_t budget_) BOOST_NOEXCEPT :
+        size( size_),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_),
+        control( control_separate),
+        label( 0)
+    {}
+
+    explicit attributes( flag_control_t control_) BOOST_NOEXCEPT :
+        size( stack_allocator::default_stacksize() ),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_),
+        label( 0)
+    {}
+
+    explicit attributes(
+            std::size_t size_,
+            flag_control_t control_) BOOST_NOEXCEPT :
+        size( size_),
+        do_unwind( stack_unwind),
+        preserve_fpu( fpu_preserved),
+        share_stack( stack_private),
+        prefault( stack_lazy),
+        color_stack( stack_uncolored),
+        budget( budget_fail),
+        control( control_),
+        label( 0)
     {}
 };
 
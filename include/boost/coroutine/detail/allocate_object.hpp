@@ -0,0 +1,248 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_ALLOCATE_OBJECT_H
+#define BOOST_COROUTINES_DETAIL_ALLOCATE_OBJECT_H
+
+#include <cstddef>
+#include <new>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/ref.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/utility.hpp>
+
+#include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/embedded_control.hpp>
+#include <boost/coroutine/detail/stack_tuple.hpp>
+#include <boost/coroutine/flags.hpp>
+#include <boost/coroutine/memory_budget.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+// memory of the control block of a coroutine, allocated by its allocator:
+//   detail::object_allocation< Allocator > block( a);
+//   T * p = block.commit( ::new( block.get() ) T( ...) );
+// - the memory is returned to the allocator if the constructor of T throws
+//   (commit() is not reached)
+template< typename Allocator >
+class object_allocation : private noncopyable
+{
+private:
+    Allocator                       &   alloc_;
+    typename Allocator::pointer         p_;
+
+public:
+    explicit object_allocation( Allocator & alloc) :
+        alloc_( alloc),
+        p_( alloc.allocate( 1) )
+    {}
+
+    ~object_allocation()
+    { if ( p_) alloc_.deallocate( p_, 1); }
+
+    void * get() const
+    { return p_; }
+
+    template< typename T >
+    T * commit( T * p)
+    {
+        p_ = 0;
+        return p;
+    }
+};
+
+// the coroutine-function the control block `Object` is created for
+template< typename Object >
+struct object_site
+{
+    static char const* name()
+    { return 0; }
+};
+
+template<
+    template< typename, typename, typename, typename, typename > class Object,
+    typename R, typename Fn, typename StackAllocator, typename Allocator, typename Caller
+>
+struct object_site< Object< R, Fn, StackAllocator, Allocator, Caller > >
+{
+    static char const* name()
+    { return site_name< Fn >(); }
+};
+
+template<
+    template< typename, typename, typename, typename, typename > class Object,
+    typename R, typename Fn, typename StackAllocator, typename Allocator, typename Caller
+>
+struct object_site< Object< R, reference_wrapper< Fn >, StackAllocator, Allocator, Caller > >
+{
+    static char const* name()
+    { return site_name< Fn >(); }
+};
+
+template<
+    template< typename, typename, typename, typename, typename > class Object,
+    typename R, typename Fn, typename StackAllocator, typename Allocator, typename Caller
+>
+struct object_site< Object< R, const reference_wrapper< Fn >, StackAllocator, Allocator, Caller > >
+{
+    static char const* name()
+    { return site_name< Fn >(); }
+};
+
+// StackAllocator of the control block `Object`
+template< typename Object >
+struct object_stack_allocator;
+
+template<
+    template< typename, typename, typename, typename, typename > class Object,
+    typename R, typename Fn, typename StackAllocator, typename Allocator, typename Caller
+>
+struct object_stack_allocator< Object< R, Fn, StackAllocator, Allocator, Caller > >
+{ typedef StackAllocator type; };
+
+// memory of the control block `Object` of a coroutine:
+//   detail::control_allocation< Object > block( a, attr, stack_alloc, site_address( fn) );
+//   Object * p = block.commit( ::new( block.get() ) Object( ..., block.stack() ) );
+// - allocated by its allocator
+// - on top of its stack if requested by attributes::control (POSIX) - the
+//   stack_tuple of the control block takes over the stack (stack()) and the
+//   stack allocator instance allocating it
+// - the memory (and a stack not taken over) is released if the constructor of
+//   Object throws (commit() is not reached)
+template< typename Object >
+class control_allocation : private noncopyable
+{
+private:
+    typedef typename Object::allocator_t                        allocator_t;
+    typedef typename object_stack_allocator< Object >::type     stack_allocator_t;
+
+    allocator_t                 &   alloc_;
+    attributes const            &   attr_;
+    stack_allocator_t               stack_alloc_;
+    void const                  *   fn_;
+    embedded_stack                  embedded_;
+    void                        *   p_;
+
+public:
+    // inlined - the memory of a separate control block is seen to be
+    // allocated by the allocator
+    BOOST_FORCEINLINE
+    control_allocation( allocator_t & alloc, attributes const& attr,
+                        stack_allocator_t const& stack_alloc, void const* fn) :
+        alloc_( alloc), attr_( attr), stack_alloc_( stack_alloc), fn_( fn), embedded_(), p_( 0)
+    {
+#if ! defined(BOOST_WINDOWS)
+        if ( embeds_control( attr_) && has_trivial_destructor< stack_allocator_t >::value)
+        {
+            p_ = allocate_on_stack( sizeof( Object) );
+            return;
+        }
+#endif
+        p_ = alloc_.allocate( 1);
+    }
+
+    ~control_allocation()
+    {
+        if ( ! p_) return;
+#if ! defined(BOOST_WINDOWS)
+        if ( embedded_.control)
+        {
+            deallocate_stack();
+            return;
+        }
+#endif
+        alloc_.deallocate( static_cast< typename allocator_t::pointer >( p_), 1);
+    }
+
+    void * get() const
+    { return p_; }
+
+    embedded_stack * stack()
+    { return & embedded_; }
+
+    Object * commit( Object * p)
+    {
+        p_ = 0;
+        return p;
+    }
+
+private:
+#if ! defined(BOOST_WINDOWS)
+    void * allocate_on_stack( std::size_t size)
+    {
+        // charged like stack_tuple does for a separate control block
+        const std::size_t charged( size + stack_allocation_size( attr_) );
+        charge_memory_budget( charged, budget_wait == attr_.budget);
+
+        char const* site( object_site< Object >::name() );
+        if ( site) assign_site( stack_alloc_, site, fn_);
+        stack_context ctx;
+        try
+        { stack_alloc_.allocate( ctx, stack_allocation_size( attr_) ); }
+        catch (...)
+        {
+            release_memory_budget( charged);
+            throw;
+        }
+
+        // the stack of the coroutine starts below the control block
+        const uintptr_t align( alignment_of< Object >::value < 16 ? 16 : alignment_of< Object >::value);
+        char * top = static_cast< char * >( ctx.sp);
+        char * p = reinterpret_cast< char * >(
+            reinterpret_cast< uintptr_t >( top - size) & ~( align - 1) );
+        embedded_.ctx = ctx;
+        embedded_.control = top - p;
+        embedded_.charged = charged;
+        embedded_.alloc = & stack_alloc_;
+        return p;
+    }
+
+    // the constructor of the control block threw before its stack_tuple took
+    // over the stack
+    void deallocate_stack()
+    {
+        if ( ! embedded_.ctx.sp) return;
+        stack_alloc_.deallocate( embedded_.ctx);
+        release_memory_budget( embedded_.charged);
+    }
+#endif
+};
+
+// destroys the control block `p` and frees its memory - a stack carrying the
+// control block is deallocated by the stack_tuple of the control block, the
+// last part of it destroyed
+template< typename Allocator, typename Object, typename StackAllocator >
+void destroy_object( Allocator & alloc, Object * p, stack_tuple< StackAllocator > const* tpl)
+{
+#if ! defined(BOOST_WINDOWS)
+    const bool embedded( 0 != tpl->embedded);
+    alloc.destroy( p);
+    if ( embedded) return;
+#else
+    ( void) tpl;
+    alloc.destroy( p);
+#endif
+    alloc.deallocate( p, 1);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_ALLOCATE_OBJECT_H
@@ -36,12 +36,40 @@
 #endif
 
 #if defined(BOOST_USE_SEGMENTED_STACKS)
-# if ! (defined(__GNUC__) && __GNUC__ > 3 && __GNUC_MINOR__ > 6)
+// -fsplit-stack: GCC 4.7 and later, Clang 3.4 and later (libgcc's runtime)
+# if defined(__clang__)
+#  if ! (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ > 3))
+#   error "compiler does not support segmented stacks"
+#  endif
+# elif ! (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ > 6)))
 #  error "compiler does not support segmented stacks"
 # endif
 # define BOOST_COROUTINES_SEGMENTS 10
 #endif
 
+// coroutine_context::jump() inline in the headers instead of called in the
+// library; the library itself and the switch of segmented stacks always
+// provide the out-of-line version
+#if defined(BOOST_COROUTINES_INLINE_JUMP) && \
+    ( defined(BOOST_COROUTINES_SOURCE) || defined(BOOST_USE_SEGMENTED_STACKS) )
+# undef BOOST_COROUTINES_INLINE_JUMP
+#endif
+
+// shared stacks per thread and stack size (attributes::share_stack)
+#if ! defined(BOOST_COROUTINES_SHARED_STACKS)
+# define BOOST_COROUTINES_SHARED_STACKS 4
+#endif
+
+// granularity of the offsets of colored stacks (attributes::color_stack)
+#if ! defined(BOOST_COROUTINES_CACHELINE_SIZE)
+# define BOOST_COROUTINES_CACHELINE_SIZE 64
+#endif
+
+// page size assumed by stacks reserved at compile time (static_stack_pool)
+#if ! defined(BOOST_COROUTINES_PAGE_SIZE)
+# define BOOST_COROUTINES_PAGE_SIZE 4096
+#endif
+
 #if defined(BOOST_COROUTINES_V2)
 # define BOOST_COROUTINES_UNIDIRECT
 #endif
@@ -0,0 +1,57 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_COPY_STACK_H
+#define BOOST_COROUTINES_DETAIL_COPY_STACK_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/context/fcontext.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+class coroutine_context;
+struct shared_stack;
+
+// coroutine running on a stack shared with other coroutines of the thread
+// (attributes::share_stack == stack_shared) - the used part of the stack is
+// copied into a buffer if another coroutine is resumed on the shared stack
+// and copied back before the coroutine is resumed
+struct copy_stack
+{
+    shared_stack                *   stack;      // assigned at first resumption
+    void                        ( * fn)( intptr_t);
+    std::size_t                     size;       // size of the shared stack
+    coroutine_context const     *   ctx;        // registers saved while suspended
+    char                        *   buffer;
+    std::size_t                     capacity;
+    std::size_t                     used;       // bytes saved in buffer
+    void                        *   owner;      // shared stacks of the creating thread
+};
+
+#if ! defined(BOOST_WINDOWS)
+BOOST_COROUTINES_DECL copy_stack * create_copy_stack( std::size_t size);
+
+BOOST_COROUTINES_DECL void destroy_copy_stack( copy_stack *);
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_COPY_STACK_H
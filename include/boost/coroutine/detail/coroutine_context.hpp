@@ -29,31 +29,57 @@ namespace boost {
 namespace coroutines {
 namespace detail {
 
-
-class BOOST_COROUTINES_DECL coroutine_context : private context::fcontext_t,
-                                                private stack_context
-                    
+struct copy_stack;
+struct stack_image;
+
+// state of a suspended context: the registers are saved in the frame of
+// jump() on the stack of the context, only their address is kept
+// - a coroutine running on a shared stack or hibernated is resumed by its
+//   base (resume_()), which keeps that state; copying a context copies the
+//   address only
+class BOOST_COROUTINES_DECL coroutine_context
 {
 private:
-    stack_context       *   stack_ctx_;
     context::fcontext_t *   ctx_;
+#if defined(BOOST_USE_SEGMENTED_STACKS)
+    void                **  segments_;
+#endif
 
 public:
     typedef void( * ctx_fn)( intptr_t);
 
     coroutine_context();
 
-    explicit coroutine_context( ctx_fn, stack_context *);
+    // context of a coroutine starting with `fn`, `copy` if it runs on a
+    // shared stack (`stack_ctx` is not allocated then)
+    coroutine_context( ctx_fn, stack_context *, copy_stack * copy);
 
-    coroutine_context( coroutine_context const&);
-
-    coroutine_context& operator=( coroutine_context const&);
+    // registers saved while suspended, 0 if never suspended
+    context::fcontext_t const* registers() const BOOST_NOEXCEPT
+    { return ctx_; }
 
     intptr_t jump( coroutine_context &, intptr_t = 0, bool = true);
+
+#if ! defined(BOOST_WINDOWS)
+    // resumes `other` running on the shared stack `copy`
+    // (copy_stack_posix.cpp)
+    intptr_t jump_copy_stack( coroutine_context & other, copy_stack * copy, intptr_t, bool);
+#endif
+
+    // releases the pages of the stack of a suspended context; returns the
+    // image keeping the used part (restore_stack()), 0 if the stack can not
+    // be hibernated
+    stack_image * hibernate( stack_context *) const;
 };
 
 }}}
 
+#if defined(BOOST_COROUTINES_INLINE_JUMP)
+# define BOOST_COROUTINES_JUMP_INLINE inline
+# include <boost/coroutine/detail/coroutine_context_jump.ipp>
+# undef BOOST_COROUTINES_JUMP_INLINE
+#endif
+
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_SUFFIX
 #endif
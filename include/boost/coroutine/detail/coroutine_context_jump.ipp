@@ -0,0 +1,24 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// switch of contiguous stacks - inline in the headers if
+// BOOST_COROUTINES_INLINE_JUMP is defined, compiled into the library otherwise
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+BOOST_COROUTINES_JUMP_INLINE intptr_t
+coroutine_context::jump( coroutine_context & other, intptr_t param, bool preserve_fpu)
+{
+    // registers of this context while suspended, the frame of jump() lives
+    // until the context is resumed
+    context::fcontext_t fctx;
+    ctx_ = & fctx;
+    return context::jump_fcontext( ctx_, other.ctx_, param, preserve_fpu);
+}
+
+}}}
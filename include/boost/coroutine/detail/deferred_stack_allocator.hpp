@@ -0,0 +1,94 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_DEFERRED_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_DEFERRED_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/slab_stack_allocator.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// deallocate() queues the stack (lock-free) instead of releasing it; queued
+// stacks are released in batches - by reclaim(), by a reaper thread or by
+// deallocate() if `batch` stacks are queued
+// - stacks are carved out of slabs (slab_stack_allocator, guard_per_stack),
+//   adjacent stacks are released by a single madvise( MADV_DONTNEED) - each
+//   call causes a TLB shootdown on all CPUs running the process
+// - the slots stay mapped for reuse, only empty slabs are unmapped
+class deferred_stack_allocator
+{
+private:
+    std::size_t             batch_;
+    slab_stack_allocator    slab_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // number of queued stacks
+    static std::size_t pending();
+
+    // releases the queued stacks, returns their number
+    static std::size_t reclaim();
+
+    // starts a thread calling reclaim() every `interval_ms` milliseconds
+    static void start_reaper( std::size_t interval_ms = 10);
+
+    // wakes the reaper thread and waits until it released the stacks queued
+    // before; releases them itself if no reaper thread is running
+    static void flush_reaper();
+
+    // stops the reaper thread and releases the queued stacks
+    static void stop_reaper();
+
+    // `batch` == 0: deallocate() never releases stacks
+    explicit deferred_stack_allocator( std::size_t batch = 0,
+                                       std::size_t stacks_per_slab = 64);
+
+    std::size_t batch() const
+    { return batch_; }
+
+    std::size_t stacks_per_slab() const
+    { return slab_.stacks_per_slab(); }
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+
+// naming a stack would split its slab
+inline
+bool labels_stacks( deferred_stack_allocator const&)
+{ return false; }
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_DEFERRED_STACK_ALLOCATOR_H
@@ -0,0 +1,48 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_EMBEDDED_CONTROL_H
+#define BOOST_COROUTINES_DETAIL_EMBEDDED_CONTROL_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+// a control block placed on top of its stack (attributes::control) is
+// allocated before its stack_tuple exists - the stack is passed explicitly
+// from the allocation of the control block to the constructor of its
+// stack_tuple, which takes it over together with the stack allocator and
+// deallocates it as the last part of the control block destroyed
+struct embedded_stack
+{
+    stack_context   ctx;        // the whole stack, 0 if not allocated or taken over
+    std::size_t     control;    // bytes at the top used by the control block
+    std::size_t     charged;    // bytes charged to memory_budget
+    void const  *   alloc;      // StackAllocator that allocated the stack
+
+    embedded_stack() :
+        ctx(), control( 0), charged( 0), alloc( 0)
+    {}
+};
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_EMBEDDED_CONTROL_H
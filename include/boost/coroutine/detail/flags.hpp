@@ -22,7 +22,10 @@ enum flag_t
     flag_complete       = 1 << 1,
     flag_unwind_stack   = 1 << 2,
     flag_force_unwind   = 1 << 3,
-    flag_preserve_fpu   = 1 << 4
+    flag_preserve_fpu   = 1 << 4,
+    flag_signal_stack   = 1 << 5,
+    flag_shared_stack   = 1 << 6,
+    flag_hibernated     = 1 << 7
 };
 
 }}}
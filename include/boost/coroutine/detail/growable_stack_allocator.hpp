@@ -0,0 +1,83 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_GROWABLE_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_GROWABLE_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// reserves a large address range per stack (PROT_NONE) and makes only the
+// requested size accessible; a SIGSEGV handler makes more of the range
+// accessible if the stack grows below the accessible part
+// - the handler runs on an alternate signal stack, installed for threads
+//   allocating stacks, resuming coroutines or calling prepare_thread()
+// - the lowest page of the range is a guard page
+class growable_stack_allocator
+{
+private:
+    std::size_t     reserve_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // installs an alternate signal stack for the calling thread - done when
+    // a coroutine with a growable stack is resumed as well
+    static void prepare_thread();
+
+    // bytes of the stack currently accessible
+    static std::size_t committed( stack_context const&);
+
+    explicit growable_stack_allocator( std::size_t reserve = 8 * 1024 * 1024);
+
+    std::size_t reserve() const
+    { return reserve_; }
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+
+// customization point: stack allocators whose stacks rely on a fault handler
+// provide an overload returning true (found via ADL) - a thread resuming such
+// a coroutine gets an alternate signal stack first
+template< typename StackAllocator >
+bool needs_signal_stack( StackAllocator const&)
+{ return false; }
+
+inline
+bool needs_signal_stack( growable_stack_allocator const&)
+{ return true; }
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_GROWABLE_STACK_ALLOCATOR_H
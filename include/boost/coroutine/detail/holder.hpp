@@ -21,23 +21,91 @@ namespace boost {
 namespace coroutines {
 namespace detail {
 
+// passes the address of the object of the side switching - the object is
+// not copied into the holder and must live until that side is resumed
+// (no temporaries bound to the constructor); the receiving side copies it
+// once or moves from it
 template< typename Data >
 struct holder
 {
-    coroutine_context      *   ctx;
-    optional< Data >        data;
+    coroutine_context  *   ctx;
+    Data const         *   data;
+    bool                    rvalue;
     bool                    force_unwind;
 
     explicit holder( coroutine_context * ctx_) :
-        ctx( ctx_), data(), force_unwind( false)
+        ctx( ctx_), data( 0), rvalue( false), force_unwind( false)
+    { BOOST_ASSERT( ctx); }
+
+    explicit holder( coroutine_context * ctx_, Data const& data_) :
+        ctx( ctx_), data( & data_), rvalue( false), force_unwind( false)
     { BOOST_ASSERT( ctx); }
 
-    explicit holder( coroutine_context * ctx_, Data data_) :
-        ctx( ctx_), data( data_), force_unwind( false)
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    explicit holder( coroutine_context * ctx_, Data && data_) :
+        ctx( ctx_), data( & data_), rvalue( true), force_unwind( false)
     { BOOST_ASSERT( ctx); }
+#endif
 
     explicit holder( coroutine_context * ctx_, bool force_unwind_) :
-        ctx( ctx_), data(), force_unwind( force_unwind_)
+        ctx( ctx_), data( 0), rvalue( false), force_unwind( force_unwind_)
+    {
+        BOOST_ASSERT( ctx);
+        BOOST_ASSERT( force_unwind);
+    }
+
+    holder( holder const& other) :
+        ctx( other.ctx), data( other.data), rvalue( other.rvalue),
+        force_unwind( other.force_unwind)
+    {}
+
+    holder & operator=( holder const& other)
+    {
+        if ( this == & other) return * this;
+        ctx = other.ctx;
+        data = other.data;
+        rvalue = other.rvalue;
+        force_unwind = other.force_unwind;
+        return * this;
+    }
+
+    // copies the passed object into `to` (moves if passed as rvalue),
+    // resets `to` if nothing was passed
+    void transfer( optional< Data > & to) const
+    {
+        if ( ! data)
+        {
+            to = none;
+            return;
+        }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        if ( rvalue)
+        {
+            to = static_cast< Data && >( * const_cast< Data * >( data) );
+            return;
+        }
+#endif
+        to = * data;
+    }
+};
+
+template< typename Data >
+struct holder< Data & >
+{
+    coroutine_context  *   ctx;
+    Data               *   data;
+    bool                    force_unwind;
+
+    explicit holder( coroutine_context * ctx_) :
+        ctx( ctx_), data( 0), force_unwind( false)
+    { BOOST_ASSERT( ctx); }
+
+    explicit holder( coroutine_context * ctx_, Data & data_) :
+        ctx( ctx_), data( & data_), force_unwind( false)
+    { BOOST_ASSERT( ctx); }
+
+    explicit holder( coroutine_context * ctx_, bool force_unwind_) :
+        ctx( ctx_), data( 0), force_unwind( force_unwind_)
     {
         BOOST_ASSERT( ctx);
         BOOST_ASSERT( force_unwind);
@@ -56,6 +124,12 @@ struct holder
         force_unwind = other.force_unwind;
         return * this;
     }
+
+    void transfer( optional< Data & > & to) const
+    {
+        if ( data) to = * data;
+        else to = none;
+    }
 };
 
 template<>
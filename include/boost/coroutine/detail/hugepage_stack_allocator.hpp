@@ -0,0 +1,78 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_HUGEPAGE_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_HUGEPAGE_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// backs stacks by huge pages in order to reduce TLB misses of large stacks
+// - tries a hugetlbfs mapping (MAP_HUGETLB) first, then an ordinary mapping
+// advised for transparent huge pages (MADV_HUGEPAGE) and finally falls back
+// to normal pages
+// the stack is aligned to and rounded up to a multiple of hugepagesize();
+// each stack is guarded by a page
+class hugepage_stack_allocator
+{
+public:
+    enum backing_t
+    {
+        normal_pages = 0,
+        transparent_huge_pages,
+        huge_pages
+    };
+
+private:
+    bool    use_hugetlb_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    static std::size_t hugepagesize();
+
+    // backing of a stack allocated by a hugepage_stack_allocator
+    static backing_t backing( stack_context const&);
+
+    // number of allocated stacks with the given backing
+    static std::size_t stacks( backing_t);
+
+    explicit hugepage_stack_allocator( bool use_hugetlb = true);
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_HUGEPAGE_STACK_ALLOCATOR_H
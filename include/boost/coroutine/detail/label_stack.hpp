@@ -0,0 +1,47 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_LABEL_STACK_H
+#define BOOST_COROUTINES_DETAIL_LABEL_STACK_H
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+// name of stack mappings in /proc/<pid>/maps ("[anon:coro-stack]")
+#if ! defined(BOOST_COROUTINES_STACK_NAME)
+# define BOOST_COROUTINES_STACK_NAME "coro-stack"
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// names the mapping of the stack "coro-stack:<label>" (or "coro-stack" if
+// `label` is 0) - ignored if the kernel does not support naming mappings
+BOOST_COROUTINES_DECL void label_stack( stack_context const&, char const* label) BOOST_NOEXCEPT;
+
+// customization point: stack allocators handing out stacks from a larger
+// mapping provide an overload returning false (found via ADL) - naming a
+// stack (attributes::label) would split the mapping
+template< typename StackAllocator >
+bool labels_stacks( StackAllocator const&)
+{ return true; }
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_LABEL_STACK_H
@@ -0,0 +1,86 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_MAGAZINE_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_MAGAZINE_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+// stacks per magazine of magazine_stack_allocator
+#if ! defined(BOOST_COROUTINES_MAGAZINE_SIZE)
+# define BOOST_COROUTINES_MAGAZINE_SIZE 16
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// caches deallocated stacks in magazines (arrays of stacks, one set for each
+// power-of-two size class):
+// - each thread holds two magazines per size class and allocates from and
+//   deallocates into them without synchronization
+// - full and empty magazines are exchanged with a global depot (lock-free)
+// a stack deallocated by another thread than the allocating one is cached by
+// the deallocating thread; its magazine reaches the allocating thread through
+// the depot if full
+// - stacks are created by standard_stack_allocator, e.g. each stack
+//   is guarded by a page
+class magazine_stack_allocator
+{
+private:
+    std::size_t     max_cached_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // number of stacks cached by all threads and the depot
+    static std::size_t cached();
+
+    // deallocates stacks of full magazines in the depot until at most `keep`
+    // stacks are cached (magazines held by threads are not touched)
+    static void trim( std::size_t keep = 0);
+
+    // deallocates the stacks cached by the calling thread
+    static void purge();
+
+    // stacks are deallocated instead of cached if `max_cached` stacks are
+    // cached (by all threads)
+    explicit magazine_stack_allocator( std::size_t max_cached = 1024);
+
+    std::size_t max_cached() const
+    { return max_cached_; }
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_MAGAZINE_STACK_ALLOCATOR_H
@@ -0,0 +1,96 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_NUMA_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_NUMA_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/flags.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// binds each stack to the NUMA node of the thread calling allocate()
+// (mbind(), Linux only) and keeps deallocated stacks in per-node free lists
+// (one list for each power-of-two size class) - a stack deallocated by a
+// thread of another node returns to the list of the node it is bound to
+// - numa_preferred (MPOL_PREFERRED) places the pages on other nodes if the node
+//   is short of memory, numa_bound (MPOL_BIND) kills the coroutine's process
+//   instead (page fault fails)
+// - stacks are guarded by a page
+// - on systems without NUMA support all stacks belong to node 0
+class numa_stack_allocator
+{
+private:
+    std::size_t     max_cached_;
+    flag_numa_t     policy_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // number of NUMA nodes (1 if unknown)
+    static std::size_t nodes();
+
+    // node of the CPU the calling thread runs on
+    static std::size_t current_node();
+
+    // node a stack is bound to
+    static std::size_t node_of( stack_context const&);
+
+    // number of stacks cached for `node`
+    static std::size_t cached( std::size_t node);
+
+    // deallocates all cached stacks
+    static void purge();
+
+    explicit numa_stack_allocator( std::size_t max_cached = 64,
+                                   flag_numa_t policy = numa_preferred);
+
+    std::size_t max_cached() const
+    { return max_cached_; }
+
+    flag_numa_t policy() const
+    { return policy_; }
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+
+// memory bound to the node of the calling thread (numa_preferred), used by
+// numa_allocator
+// - blocks up to 2kB are carved from per-node chunks and reused
+BOOST_COROUTINES_DECL void * numa_allocate( std::size_t);
+
+BOOST_COROUTINES_DECL void numa_deallocate( void *, std::size_t) BOOST_NOEXCEPT;
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_NUMA_STACK_ALLOCATOR_H
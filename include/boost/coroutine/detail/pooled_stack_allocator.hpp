@@ -0,0 +1,72 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_POOLED_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_POOLED_STACK_ALLOCATOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// keeps deallocated stacks in per-thread free lists (one list for each
+// power-of-two size class) and hands them out again on the next allocate()
+// - stacks are created by standard_stack_allocator, e.g. each stack
+// is guarded by a page
+class pooled_stack_allocator
+{
+private:
+    std::size_t     max_cached_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // number of stacks cached by the calling thread
+    static std::size_t cached();
+
+    // deallocates all stacks cached by the calling thread
+    static void purge();
+
+    explicit pooled_stack_allocator( std::size_t max_cached = 64);
+
+    std::size_t max_cached() const
+    { return max_cached_; }
+
+    // fills the pool of the calling thread with `count` stacks of `size` bytes
+    void prewarm( std::size_t size, std::size_t count);
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_POOLED_STACK_ALLOCATOR_H
@@ -0,0 +1,69 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_SITE_NAME_H
+#define BOOST_COROUTINES_DETAIL_SITE_NAME_H
+
+#if ! defined(BOOST_NO_TYPEID)
+# include <typeinfo>
+#endif
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_function.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+// identifies the coroutine-function a stack is allocated for
+template< typename Fn >
+char const* site_name()
+{
+#if defined(BOOST_NO_TYPEID)
+    return 0;
+#else
+    return typeid( Fn).name();
+#endif
+}
+
+template< typename Fn >
+void const* site_address_( Fn const&, false_type)
+{ return 0; }
+
+template< typename Fn >
+void const* site_address_( Fn const& fn, true_type)
+{
+    typename decay< Fn >::type p = fn;
+    return reinterpret_cast< void const* >( reinterpret_cast< uintptr_t >( p) );
+}
+
+// plain functions of the same signature share site_name() - they are told
+// apart by their address (0 for function objects)
+template< typename Fn >
+void const* site_address( Fn const& fn)
+{
+    typedef typename remove_pointer< typename decay< Fn >::type >::type function_t;
+    return site_address_( fn, integral_constant< bool, is_function< function_t >::value >() );
+}
+
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_SITE_NAME_H
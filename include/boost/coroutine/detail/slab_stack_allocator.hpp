@@ -0,0 +1,90 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_SLAB_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_DETAIL_SLAB_STACK_ALLOCATOR_H
+
+#include <cstddef>
+#include <utility>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/flags.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+#if ! defined(BOOST_WINDOWS)
+// carves stacks out of large mappings (slabs) holding `stacks_per_slab`
+// stacks of equal size - a process requires only a few memory mappings
+// for many stacks
+// guard_per_stack protects the page below each stack - the mapping is split
+// at each guard page unless the kernel installs guard pages without changing
+// the protection (MADV_GUARD_INSTALL, Linux >= 6.13); guard_per_slab protects
+// only the page below the lowest stack of a slab; guard_auto selects
+// guard_per_stack if supported without splitting, guard_per_slab otherwise
+class slab_stack_allocator
+{
+private:
+    std::size_t     stacks_per_slab_;
+    flag_guard_t    guard_;
+
+public:
+    static bool is_stack_unbound();
+
+    static std::size_t default_stacksize();
+
+    static std::size_t minimum_stacksize();
+
+    static std::size_t maximum_stacksize();
+
+    // guard pages can be installed without splitting a slab
+    static bool lightweight_guards();
+
+    explicit slab_stack_allocator( std::size_t stacks_per_slab = 64,
+                                   flag_guard_t guard = guard_auto);
+
+    std::size_t stacks_per_slab() const
+    { return stacks_per_slab_; }
+
+    // guard mode in effect, never guard_auto
+    flag_guard_t guard() const
+    { return guard_; }
+
+    void allocate( stack_context &, std::size_t);
+
+    void deallocate( stack_context &);
+};
+
+// naming a stack would split its slab
+inline
+bool labels_stacks( slab_stack_allocator const&)
+{ return false; }
+
+typedef std::pair< char *, std::size_t >    slab_slot;  // start of the guard page, size
+
+// returns `n` slots allocated by slab_stack_allocator, sorted by address -
+// the physical memory of adjacent slots is released by a single madvise(),
+// the slots are released under one lock; returns the number of madvise() calls
+std::size_t release_slab_slots( slab_slot const* slots, std::size_t n);
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_SLAB_STACK_ALLOCATOR_H
@@ -0,0 +1,46 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_STACK_COLOR_H
+#define BOOST_COROUTINES_DETAIL_STACK_COLOR_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+// bytes to add to the requested size of a stack which is colored
+BOOST_COROUTINES_DECL std::size_t stack_color_padding();
+
+// moves the top of the stack down by a multiple of the cache line size
+// (less than a page) so that the top frames of coroutines are spread over
+// the cache sets; returns the offset
+BOOST_COROUTINES_DECL std::size_t color_stack( stack_context &);
+
+inline
+void uncolor_stack( stack_context & sctx, std::size_t offset)
+{
+    sctx.sp = static_cast< char * >( sctx.sp) + offset;
+    sctx.size += offset;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_STACK_COLOR_H
@@ -0,0 +1,48 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_STACK_IMAGE_H
+#define BOOST_COROUTINES_DETAIL_STACK_IMAGE_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+// used part of the stack of a hibernated coroutine - the pages of the
+// stack are released until the coroutine is resumed
+struct stack_image
+{
+    char            *   top;
+    char            *   buffer;
+    std::size_t         size;
+};
+
+// copies the stack above `sp` into an image and releases the stack pages
+BOOST_COROUTINES_DECL stack_image * hibernate_stack( stack_context const&, void * sp);
+
+// copies the image back into the stack and destroys the image
+BOOST_COROUTINES_DECL void restore_stack( stack_image *) BOOST_NOEXCEPT;
+
+BOOST_COROUTINES_DECL void destroy_stack_image( stack_image *) BOOST_NOEXCEPT;
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_STACK_IMAGE_H
@@ -11,7 +11,18 @@
 
 #include <boost/config.hpp>
 
+#include <boost/coroutine/attributes.hpp>
 #include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/copy_stack.hpp>
+#include <boost/coroutine/detail/embedded_control.hpp>
+#include <boost/coroutine/detail/growable_stack_allocator.hpp>
+#include <boost/coroutine/detail/label_stack.hpp>
+#include <boost/coroutine/detail/prefault_stack.hpp>
+#include <boost/coroutine/detail/site_name.hpp>
+#include <boost/coroutine/detail/stack_color.hpp>
+#include <boost/coroutine/flags.hpp>
+#include <boost/coroutine/memory_budget.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
 #include <boost/coroutine/stack_context.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -22,19 +33,231 @@ namespace boost {
 namespace coroutines {
 namespace detail {
 
+// customization point: stack allocators interested in the coroutine-function
+// a stack is allocated for provide an overload (found via ADL)
+// `fn`: address of the coroutine-function, 0 if it is a function object
+template< typename StackAllocator >
+void assign_site( StackAllocator &, char const*, void const*)
+{}
+
+// bytes allocated for the (private) stack of a coroutine
+inline
+std::size_t stack_allocation_size( attributes const& attr)
+{
+#if defined(BOOST_USE_SEGMENTED_STACKS)
+    return attr.size;
+#else
+    return stack_colored == attr.color_stack ? attr.size + stack_color_padding() : attr.size;
+#endif
+}
+
+#if ! defined(BOOST_WINDOWS)
+// true if the control block of the coroutine is placed on top of its stack
+inline
+bool embeds_control( attributes const& attr)
+{
+# if defined(BOOST_USE_SEGMENTED_STACKS)
+    ( void) attr;
+    return false;
+# else
+    return control_on_stack == attr.control && stack_private == attr.share_stack;
+# endif
+}
+#endif
+
 template< typename StackAllocator >
 struct stack_tuple
 {
     coroutines::stack_context   stack_ctx;
+    copy_stack              *   copy;       // shared stack the coroutine runs on
     StackAllocator              stack_alloc;
+    std::size_t                 color;
+    bool                        labeled;
+    std::size_t                 charged;    // bytes charged to memory_budget
+    void                    *   overflow;   // registered for overflow_diagnostics
+    std::size_t                 embedded;   // bytes at the top of the stack used by the control block
+    bool                        signal_stack; // resuming threads need an alternate signal stack
 
     stack_tuple( StackAllocator const& stack_alloc_, std::size_t size) :
         stack_ctx(),
-        stack_alloc( stack_alloc_)
-    { stack_alloc.allocate( stack_ctx, size); }
+        copy( 0),
+        stack_alloc( stack_alloc_),
+        color( 0),
+        labeled( false),
+        charged( 0),
+        overflow( 0),
+        embedded( 0),
+        signal_stack( false)
+    {
+        stack_alloc.allocate( stack_ctx, size);
+#if ! defined(BOOST_WINDOWS)
+        signal_stack = needs_signal_stack( stack_alloc);
+#endif
+    }
+
+    // `site`, `fn`: coroutine-function the stack is allocated for
+    // `control`: size of the control block containing the stack_tuple
+    // `stack`: stack carrying the control block (attributes::control), 0 or
+    // not allocated if the control block was allocated separately - taken
+    // over with the stack allocator instance that allocated it
+    stack_tuple( StackAllocator const& stack_alloc_, attributes const& attr,
+                 char const* site, void const* fn, std::size_t control,
+                 embedded_stack * stack) :
+        stack_ctx(),
+        copy( 0),
+        stack_alloc( stack && stack->ctx.sp
+            ? * static_cast< StackAllocator const* >( stack->alloc)
+            : stack_alloc_),
+        color( 0),
+        labeled( false),
+        charged( 0),
+        overflow( 0),
+        embedded( 0),
+        signal_stack( false)
+    {
+#if ! defined(BOOST_WINDOWS)
+        if ( site && ! ( stack && stack->ctx.sp) ) assign_site( stack_alloc, site, fn);
+# if defined(BOOST_USE_SEGMENTED_STACKS)
+        // segmented stacks are not shared
+        const bool shared = false;
+# else
+        const bool shared( stack_shared == attr.share_stack);
+# endif
+        // the stack was allocated (and charged) together with the control
+        // block placed on top of it
+        if ( stack && stack->ctx.sp)
+        {
+            stack_ctx = stack->ctx;
+            embedded = stack->control;
+            charged = stack->charged;
+            stack_ctx.sp = static_cast< char * >( stack_ctx.sp) - embedded;
+            stack_ctx.size -= embedded;
+        }
+        else
+        {
+            // admission before any stack is allocated
+            charged = shared ? control : control + stack_allocation_size( attr);
+            charge_memory_budget( charged, budget_wait == attr.budget);
+
+            // runs on a shared stack - no stack is allocated
+            if ( shared)
+            {
+                try
+                { copy = create_copy_stack( attr.size); }
+                catch (...)
+                {
+                    release_memory_budget( charged);
+                    throw;
+                }
+                return;
+            }
+            allocate_stack( stack_allocation_size( attr) );
+        }
+#else
+        ( void) control;
+        ( void) stack;
+        allocate_stack( stack_allocation_size( attr) );
+#endif
+#if ! defined(BOOST_USE_SEGMENTED_STACKS)
+        if ( stack_colored == attr.color_stack)
+            color = color_stack( stack_ctx);
+        // the coroutine must not fault on its stack if resumed
+        if ( stack_lazy != attr.prefault)
+        {
+            try
+            { prefault_stack( stack_ctx, attr.size, stack_locked == attr.prefault); }
+            catch (...)
+            {
+                release_stack();
+                throw;
+            }
+        }
+#endif
+#if ! defined(BOOST_WINDOWS)
+        signal_stack = needs_signal_stack( stack_alloc);
+        if ( attr.label && labels_stacks( stack_alloc) )
+        {
+            label_stack( stack_ctx, attr.label);
+            labeled = true;
+        }
+        try
+        { overflow = register_overflow_stack( stack_ctx, attr.size, attr.label, site); }
+        catch (...)
+        {
+            if ( labeled) label_stack( stack_ctx, 0);
+            release_stack();
+            throw;
+        }
+        // deallocated by this stack_tuple from now on
+        if ( embedded) stack->ctx = coroutines::stack_context();
+#endif
+    }
 
     ~stack_tuple()
-    { stack_alloc.deallocate( stack_ctx); }
+    {
+#if ! defined(BOOST_WINDOWS)
+        if ( copy)
+        {
+            destroy_copy_stack( copy);
+            release_memory_budget( charged);
+            return;
+        }
+        unregister_overflow_stack( overflow);
+        // a stack cached by the allocator gets its default name back
+        if ( labeled) label_stack( stack_ctx, 0);
+#endif
+        release_stack();
+#if ! defined(BOOST_WINDOWS)
+        // the rest of the control block is destroyed already - the stack
+        // carrying it is deallocated as the last step
+        if ( embedded) deallocate_embedded_stack();
+#endif
+    }
+
+private:
+    void allocate_stack( std::size_t size)
+    {
+#if defined(BOOST_WINDOWS)
+        stack_alloc.allocate( stack_ctx, size);
+#else
+        try
+        { stack_alloc.allocate( stack_ctx, size); }
+        catch (...)
+        {
+            release_memory_budget( charged);
+            throw;
+        }
+#endif
+    }
+
+    void release_stack()
+    {
+        uncolor_stack( stack_ctx, color);
+#if ! defined(BOOST_WINDOWS)
+        // the stack still holds the control block - it is deallocated after
+        // the control block was destroyed
+        if ( embedded) return;
+#endif
+        stack_alloc.deallocate( stack_ctx);
+#if ! defined(BOOST_WINDOWS)
+        release_memory_budget( charged);
+#endif
+    }
+
+#if ! defined(BOOST_WINDOWS)
+    // releases the memory of this stack_tuple - nothing of it is touched
+    // afterwards (StackAllocator has a trivial destructor, control_allocation)
+    void deallocate_embedded_stack()
+    {
+        coroutines::stack_context ctx( stack_ctx);
+        ctx.sp = static_cast< char * >( ctx.sp) + embedded;
+        ctx.size += embedded;
+        StackAllocator alloc( stack_alloc);
+        const std::size_t charged_( charged);
+        alloc.deallocate( ctx);
+        release_memory_budget( charged_);
+    }
+#endif
 };
 
 
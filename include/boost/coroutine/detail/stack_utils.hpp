@@ -0,0 +1,128 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_DETAIL_STACK_UTILS_H
+#define BOOST_COROUTINES_DETAIL_STACK_UTILS_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/context/fcontext.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#if ! defined(BOOST_WINDOWS)
+extern "C" {
+#include <pthread.h>
+#include <signal.h>
+}
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+namespace detail {
+
+// implemented by standard_stack_allocator_{posix,windows}.cpp
+std::size_t pagesize();
+
+std::size_t page_count( std::size_t);
+
+// stack pointer saved by jump_fcontext() for a suspended context - the stack
+// above it is in use, the stack below it is free; 0 if the layout of
+// fcontext_t is unknown for the architecture
+inline char * saved_stack_pointer( context::fcontext_t const& fctx)
+{
+#if defined(BOOST_WINDOWS) && ( defined(_M_X64) || defined(__x86_64__) )
+    // r12, r13, r14, r15, rdi, rsi, rbx, rbp, rsp, rip
+    return reinterpret_cast< char * >( fctx.fc_greg[8]);
+#elif defined(_M_X64) || defined(__x86_64__)
+    // rbx, r12, r13, r14, r15, rbp, rsp, rip
+    return reinterpret_cast< char * >( fctx.fc_greg[6]);
+#elif defined(_M_IX86) || defined(__i386__)
+    // edi, esi, ebx, ebp, esp, eip
+    return reinterpret_cast< char * >( fctx.fc_greg[4]);
+#else
+    return 0;
+#endif
+}
+
+#if ! defined(BOOST_WINDOWS)
+// flags passed to mmap() for stack memory
+// (anonymous, private, without swap reservation if supported)
+int stack_map_flags();
+
+// bookkeeping of stack_statistics (stack_statistics_posix.cpp)
+// - mapped/unmapped: address ranges backing stacks, including cached stacks
+// - allocated/deallocated: stacks handed out by/returned to an allocator
+void record_stack_mapped( void * base, std::size_t size);
+
+void record_stack_unmapped( void * base, std::size_t size);
+
+void record_stack_allocated();
+
+void record_stack_deallocated();
+
+void record_pool_lookup( bool hit);
+
+// names the mapping (label_stack_posix.cpp) - called by the allocators for
+// each mapping backing stacks
+void name_stack_mapping( void * base, std::size_t size, char const* label) BOOST_NOEXCEPT;
+
+// maps/unmaps a stack like standard_stack_allocator without counting it as
+// allocated - used by allocators caching stacks
+void map_stack( stack_context &, std::size_t);
+
+void unmap_stack( stack_context &);
+
+// power-of-two size classes of the allocators caching stacks: size class k
+// holds stacks of 2^k pages (+ one guard page) mapped by map_stack()
+const std::size_t size_classes = sizeof( std::size_t) * 8;
+
+// size class a request of `size` bytes is rounded up to
+std::size_t size_class_of_request( std::size_t size);
+
+// returns size_classes if the stack does not belong to any size class
+std::size_t size_class_of_stack( stack_context const&);
+
+// stacks of size class k do not exceed the maximum stack size
+bool is_poolable( std::size_t k);
+
+// passes a signal on to the handler `previous` replaced by a handler of this
+// library (overflow_diagnostics_posix.cpp)
+void chain_signal( struct sigaction const& previous, int sig, siginfo_t *, void * uctx);
+
+class mutex_guard
+{
+private:
+    pthread_mutex_t *   mtx_;
+
+    mutex_guard( mutex_guard const&);
+    mutex_guard & operator=( mutex_guard const&);
+
+public:
+    explicit mutex_guard( pthread_mutex_t * mtx) :
+        mtx_( mtx)
+    { ::pthread_mutex_lock( mtx_); }
+
+    ~mutex_guard()
+    { ::pthread_mutex_unlock( mtx_); }
+};
+#endif
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_DETAIL_STACK_UTILS_H
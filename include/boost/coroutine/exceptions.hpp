@@ -32,7 +32,9 @@ struct forced_unwind {};
 
 BOOST_SCOPED_ENUM_DECLARE_BEGIN(coroutine_errc)
 {
-  no_data = 1
+  no_data = 1,
+  stack_pool_exhausted,
+  memory_budget_exceeded
 }
 BOOST_SCOPED_ENUM_DECLARE_END(coroutine_errc)
 
@@ -96,6 +98,26 @@ public:
     {}
 };
 
+class stack_pool_exhausted : public coroutine_error
+{
+public:
+    stack_pool_exhausted() :
+        coroutine_error(
+            system::make_error_code(
+                coroutine_errc::stack_pool_exhausted) )
+    {}
+};
+
+class memory_budget_exceeded : public coroutine_error
+{
+public:
+    memory_budget_exceeded() :
+        coroutine_error(
+            system::make_error_code(
+                coroutine_errc::memory_budget_exceeded) )
+    {}
+};
+
 }}
 
 #ifdef BOOST_HAS_ABI_HEADERS
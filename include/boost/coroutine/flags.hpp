@@ -22,6 +22,51 @@ enum flag_fpu_t
     fpu_not_preserved
 };
 
+enum flag_stack_t
+{
+    stack_private = 0,
+    stack_shared
+};
+
+enum flag_guard_t
+{
+    guard_auto = 0,
+    guard_per_stack,
+    guard_per_slab,
+    guard_none
+};
+
+enum flag_prefault_t
+{
+    stack_lazy = 0,
+    stack_prefaulted,
+    stack_locked
+};
+
+enum flag_color_t
+{
+    stack_uncolored = 0,
+    stack_colored
+};
+
+enum flag_budget_t
+{
+    budget_fail = 0,
+    budget_wait
+};
+
+enum flag_control_t
+{
+    control_separate = 0,
+    control_on_stack
+};
+
+enum flag_numa_t
+{
+    numa_preferred = 0,
+    numa_bound
+};
+
 }}
 
 #endif // BOOST_COROUTINES_FLAGS_H
@@ -0,0 +1,81 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_MEMORY_BUDGET_H
+#define BOOST_COROUTINES_MEMORY_BUDGET_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// process wide limit of the memory used by coroutines: the stack and the
+// control block of each coroutine are charged when it is constructed
+// - a coroutine exceeding the limit throws memory_budget_exceeded or waits
+//   until other coroutines are destroyed (attributes::budget)
+struct memory_budget
+{
+    // `bytes` == 0: no limit (default)
+    static void limit( std::size_t bytes);
+
+    static std::size_t limit();
+
+    // bytes charged by living coroutines
+    static std::size_t used();
+
+    // constructors of coroutines waiting for the budget (attributes::budget)
+    static std::size_t waiting();
+};
+
+namespace detail {
+
+BOOST_COROUTINES_DECL void set_memory_budget( std::size_t);
+
+BOOST_COROUTINES_DECL std::size_t memory_budget_limit();
+
+BOOST_COROUTINES_DECL std::size_t memory_budget_used();
+
+BOOST_COROUTINES_DECL std::size_t memory_budget_waiting();
+
+BOOST_COROUTINES_DECL void charge_memory_budget( std::size_t, bool wait);
+
+BOOST_COROUTINES_DECL void release_memory_budget( std::size_t) BOOST_NOEXCEPT;
+
+}
+
+inline
+void memory_budget::limit( std::size_t bytes)
+{ detail::set_memory_budget( bytes); }
+
+inline
+std::size_t memory_budget::limit()
+{ return detail::memory_budget_limit(); }
+
+inline
+std::size_t memory_budget::used()
+{ return detail::memory_budget_used(); }
+
+inline
+std::size_t memory_budget::waiting()
+{ return detail::memory_budget_waiting(); }
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_MEMORY_BUDGET_H
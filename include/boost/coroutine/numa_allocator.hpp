@@ -0,0 +1,93 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_NUMA_ALLOCATOR_H
+#define BOOST_COROUTINES_NUMA_ALLOCATOR_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/numa_stack_allocator.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// allocator for the control blocks of coroutines (and other objects):
+// the memory is bound to the NUMA node of the thread calling allocate(),
+// matching numa_stack_allocator
+template< typename T >
+class numa_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T           *   pointer;
+    typedef T const     *   const_pointer;
+    typedef T           &   reference;
+    typedef T const     &   const_reference;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    template< typename U >
+    struct rebind
+    { typedef numa_allocator< U >   other; };
+
+    numa_allocator() BOOST_NOEXCEPT
+    {}
+
+    template< typename U >
+    numa_allocator( numa_allocator< U > const&) BOOST_NOEXCEPT
+    {}
+
+    pointer address( reference x) const
+    { return & x; }
+
+    const_pointer address( const_reference x) const
+    { return & x; }
+
+    pointer allocate( size_type n, void const* = 0)
+    {
+        if ( max_size() < n) throw std::bad_alloc();
+        return static_cast< pointer >( detail::numa_allocate( n * sizeof( T) ) );
+    }
+
+    void deallocate( pointer p, size_type n)
+    { detail::numa_deallocate( p, n * sizeof( T) ); }
+
+    size_type max_size() const BOOST_NOEXCEPT
+    { return ( std::numeric_limits< size_type >::max)() / sizeof( T); }
+
+    void construct( pointer p, const_reference x)
+    { ::new( static_cast< void * >( p) ) T( x); }
+
+    void destroy( pointer p)
+    { p->~T(); }
+};
+
+template< typename T, typename U >
+bool operator==( numa_allocator< T > const&, numa_allocator< U > const&) BOOST_NOEXCEPT
+{ return true; }
+
+template< typename T, typename U >
+bool operator!=( numa_allocator< T > const&, numa_allocator< U > const&) BOOST_NOEXCEPT
+{ return false; }
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_NUMA_ALLOCATOR_H
@@ -0,0 +1,70 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_OVERFLOW_DIAGNOSTICS_H
+#define BOOST_COROUTINES_OVERFLOW_DIAGNOSTICS_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+struct stack_context;
+
+#if ! defined(BOOST_WINDOWS)
+// reports a fault in the guard page of a coroutine's stack - label, creation
+// site and size of the coroutine - before the fault is passed on to the
+// previous handler (e.g. the process terminates and dumps core)
+// - only coroutines created after enable() are recognized
+// - the handler runs on an alternate signal stack, installed for threads
+//   creating coroutines or calling prepare_thread()
+struct overflow_diagnostics
+{
+    // installs the handler for SIGSEGV and SIGBUS, the report is written to `fd`
+    static void enable( int fd = 2);
+
+    // installs an alternate signal stack for the calling thread
+    static void prepare_thread();
+};
+
+namespace detail {
+
+BOOST_COROUTINES_DECL void enable_overflow_diagnostics( int);
+
+BOOST_COROUTINES_DECL void prepare_signal_stack();
+
+// returns a handle for unregister_overflow_stack(), 0 if not enabled
+BOOST_COROUTINES_DECL void * register_overflow_stack(
+        stack_context const&, std::size_t size, char const* label, char const* site);
+
+BOOST_COROUTINES_DECL void unregister_overflow_stack( void *) BOOST_NOEXCEPT;
+
+}
+
+inline
+void overflow_diagnostics::enable( int fd)
+{ detail::enable_overflow_diagnostics( fd); }
+
+inline
+void overflow_diagnostics::prepare_thread()
+{ detail::prepare_signal_stack(); }
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_OVERFLOW_DIAGNOSTICS_H
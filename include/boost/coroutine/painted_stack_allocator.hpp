@@ -0,0 +1,170 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_PAINTED_STACK_ALLOCATOR_H
+#define BOOST_COROUTINES_PAINTED_STACK_ALLOCATOR_H
+
+#include <cstddef>
+#include <iosfwd>
+
+#include <boost/config.hpp>
+#include <boost/type_traits/decay.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/label_stack.hpp>
+#include <boost/coroutine/detail/site_name.hpp>
+#include <boost/coroutine/stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// statistics of the stacks allocated for one call site
+struct stack_usage
+{
+    std::size_t     stacks;     // stacks allocated
+    std::size_t     live;       // stacks not yet deallocated
+    std::size_t     size;       // largest stack
+    std::size_t     max_used;   // deepest stack usage
+
+    stack_usage() :
+        stacks( 0), live( 0), size( 0), max_used( 0)
+    {}
+};
+
+namespace detail {
+
+BOOST_COROUTINES_DECL void paint_stack( stack_context const&, char const*);
+
+BOOST_COROUTINES_DECL void unpaint_stack( stack_context const&);
+
+BOOST_COROUTINES_DECL std::size_t painted_stack_used( stack_context const&);
+
+BOOST_COROUTINES_DECL stack_usage painted_stack_usage( char const*);
+
+BOOST_COROUTINES_DECL void painted_stack_report( std::ostream &);
+
+BOOST_COROUTINES_DECL std::size_t painted_stack_peak( char const*);
+
+BOOST_COROUTINES_DECL void painted_stack_save( std::ostream &);
+
+BOOST_COROUTINES_DECL void painted_stack_load( std::istream &);
+
+// `type` if `fn` is 0, otherwise a name unique to the function at `fn`
+BOOST_COROUTINES_DECL char const* function_site( char const* type, void const* fn);
+
+template< typename Fn >
+char const* function_site( Fn const& fn)
+{
+    char const* type( site_name< typename decay< Fn >::type >() );
+    return function_site( type ? type : "", site_address( fn) );
+}
+
+}
+
+// fills each stack with a pattern at allocation - the deepest stack usage
+// is the part of the stack where the pattern was overwritten
+// statistics are collected per call site (a label passed to the constructor
+// or, if no label is given, the type of the coroutine-function)
+template< typename StackAllocator = stack_allocator >
+class painted_stack_allocator
+{
+private:
+    template< typename X >
+    friend void assign_site( painted_stack_allocator< X > &, char const*, void const*);
+
+    template< typename X >
+    friend bool labels_stacks( painted_stack_allocator< X > const&);
+
+    template< typename X >
+    friend bool needs_signal_stack( painted_stack_allocator< X > const&);
+
+    StackAllocator      alloc_;
+    char const      *   site_;
+
+public:
+    static bool is_stack_unbound()
+    { return StackAllocator::is_stack_unbound(); }
+
+    static std::size_t default_stacksize()
+    { return StackAllocator::default_stacksize(); }
+
+    static std::size_t minimum_stacksize()
+    { return StackAllocator::minimum_stacksize(); }
+
+    static std::size_t maximum_stacksize()
+    { return StackAllocator::maximum_stacksize(); }
+
+    // deepest usage of an allocated stack (in bytes)
+    static std::size_t used( stack_context const& ctx)
+    { return detail::painted_stack_used( ctx); }
+
+    // statistics of a call site, includes the stacks not yet deallocated
+    static stack_usage usage( char const* site)
+    { return detail::painted_stack_usage( site); }
+
+    // writes the statistics of all call sites
+    static void report( std::ostream & os)
+    { detail::painted_stack_report( os); }
+
+    explicit painted_stack_allocator( char const* site = "",
+                                      StackAllocator const& alloc = StackAllocator() ) :
+        alloc_( alloc), site_( site)
+    {}
+
+    char const* site() const
+    { return site_; }
+
+    // call site the stacks of the coroutine-function `fn` are accounted to
+    // if no label was given
+    template< typename Fn >
+    static char const* site( Fn const& fn)
+    { return detail::function_site( fn); }
+
+    void allocate( stack_context & ctx, std::size_t size)
+    {
+        alloc_.allocate( ctx, size);
+        detail::paint_stack( ctx, site_);
+    }
+
+    void deallocate( stack_context & ctx)
+    {
+        detail::unpaint_stack( ctx);
+        alloc_.deallocate( ctx);
+    }
+};
+
+template< typename StackAllocator >
+void assign_site( painted_stack_allocator< StackAllocator > & alloc, char const* site, void const* fn)
+{ if ( '\0' == * alloc.site_) alloc.site_ = detail::function_site( site, fn); }
+
+template< typename StackAllocator >
+bool labels_stacks( painted_stack_allocator< StackAllocator > const& alloc)
+{
+    using detail::labels_stacks;
+    return labels_stacks( alloc.alloc_);
+}
+
+template< typename StackAllocator >
+bool needs_signal_stack( painted_stack_allocator< StackAllocator > const& alloc)
+{
+    using detail::needs_signal_stack;
+    return needs_signal_stack( alloc.alloc_);
+}
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_PAINTED_STACK_ALLOCATOR_H
@@ -12,7 +12,14 @@
 #include <boost/config.hpp>
 
 #include <boost/context/detail/config.hpp>
+#include <boost/coroutine/detail/deferred_stack_allocator.hpp>
+#include <boost/coroutine/detail/growable_stack_allocator.hpp>
+#include <boost/coroutine/detail/hugepage_stack_allocator.hpp>
+#include <boost/coroutine/detail/magazine_stack_allocator.hpp>
+#include <boost/coroutine/detail/numa_stack_allocator.hpp>
+#include <boost/coroutine/detail/pooled_stack_allocator.hpp>
 #include <boost/coroutine/detail/segmented_stack_allocator.hpp>
+#include <boost/coroutine/detail/slab_stack_allocator.hpp>
 #include <boost/coroutine/detail/standard_stack_allocator.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -28,6 +35,16 @@ typedef detail::segmented_stack_allocator   stack_allocator;
 typedef detail::standard_stack_allocator    stack_allocator;
 #endif
 
+#if ! defined(BOOST_WINDOWS)
+typedef detail::deferred_stack_allocator    deferred_stack_allocator;
+typedef detail::growable_stack_allocator    growable_stack_allocator;
+typedef detail::hugepage_stack_allocator    hugepage_stack_allocator;
+typedef detail::magazine_stack_allocator    magazine_stack_allocator;
+typedef detail::numa_stack_allocator        numa_stack_allocator;
+typedef detail::pooled_stack_allocator      pooled_stack_allocator;
+typedef detail::slab_stack_allocator        slab_stack_allocator;
+#endif
+
 }}
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -0,0 +1,77 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_STACK_STATISTICS_H
+#define BOOST_COROUTINES_STACK_STATISTICS_H
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// memory used by the stacks of the stack allocators of this library
+// (process wide, counted since start)
+struct stack_statistics
+{
+    std::size_t     allocations;    // stacks handed out by allocate()
+    std::size_t     deallocations;  // stacks returned by deallocate()
+    std::size_t     live;           // stacks in use
+    std::size_t     peak_live;
+    std::size_t     mappings;       // address ranges backing stacks (incl. cached stacks)
+    std::size_t     reserved;       // bytes of address space of these ranges
+    std::size_t     peak_reserved;
+    std::size_t     resident;       // bytes of the ranges mapped while sampling in physical memory
+    std::size_t     pool_hits;      // stacks taken from a cache
+    std::size_t     pool_misses;    // stacks not found in a cache
+
+    double pool_hit_rate() const
+    {
+        return 0 == pool_hits + pool_misses
+            ? 0. : static_cast< double >( pool_hits) / ( pool_hits + pool_misses);
+    }
+
+    // address ranges mapped while enabled are registered for sampling
+    // `resident` (a mutex and a map insert per mapping); disabling forgets them
+    static void sample_resident( bool enable);
+
+    // `resident` is determined by mincore() for at most `samples` registered
+    // address ranges and extrapolated to all registered ranges
+    static stack_statistics snapshot( std::size_t samples = 64);
+};
+
+namespace detail {
+
+BOOST_COROUTINES_DECL void stack_statistics_sample_resident( bool);
+
+BOOST_COROUTINES_DECL stack_statistics stack_statistics_snapshot( std::size_t);
+
+}
+
+inline
+void stack_statistics::sample_resident( bool enable)
+{ detail::stack_statistics_sample_resident( enable); }
+
+inline
+stack_statistics stack_statistics::snapshot( std::size_t samples)
+{ return detail::stack_statistics_snapshot( samples); }
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_STACK_STATISTICS_H
@@ -0,0 +1,180 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COROUTINES_STATIC_STACK_POOL_H
+#define BOOST_COROUTINES_STATIC_STACK_POOL_H
+
+#include <cstddef>
+#include <new>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/exceptions.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#if ! defined(BOOST_WINDOWS)
+extern "C" {
+#include <sys/mman.h>
+#include <unistd.h>
+}
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+
+#if ! defined(BOOST_WINDOWS)
+// hands out `N` stacks of `Size` bytes from a region reserved at compile
+// time (zero-initialized data, no mmap())
+// - allocate() and deallocate() take O(1) (lock-free free list of slots)
+// - if `Guard` is true, the lowest page of each slot is protected when the
+//   slot is used the first time
+// - allocate() throws stack_pool_exhausted if all stacks are in use and
+//   std::bad_alloc if a guard page can not be installed
+// all instances of one static_stack_pool<> type share the same pool
+template< std::size_t N, std::size_t Size, bool Guard = true >
+class static_stack_pool
+{
+private:
+    BOOST_STATIC_ASSERT( 0 < N && N < 0xffffffff);
+    BOOST_STATIC_ASSERT( 0 < Size);
+
+    static const std::size_t page = BOOST_COROUTINES_PAGE_SIZE;
+    static const std::size_t guard = Guard ? BOOST_COROUTINES_PAGE_SIZE : 0;
+    static const std::size_t slot = ( Size + page - 1) / page * page + guard;
+
+    struct pool
+    {
+        char                storage[N * slot] __attribute__((aligned(BOOST_COROUTINES_PAGE_SIZE)));
+        // free list: ABA tag in the upper, slot + 1 in the lower 32 bits
+        volatile uint64_t   head;
+        uint32_t            next[N];
+        // slots [unused, N) were never handed out
+        volatile uint32_t   unused;
+        volatile uint32_t   used;
+    };
+
+    static pool     pool_;
+
+    static bool protect( std::size_t idx)
+    {
+        if ( ! Guard) return true;
+        // BOOST_COROUTINES_PAGE_SIZE smaller than the page size - the guard
+        // would not cover whole pages
+        if ( static_cast< long >( page) < ::sysconf( _SC_PAGESIZE) ) return false;
+        return 0 == ::mprotect( pool_.storage + idx * slot, guard, PROT_NONE);
+    }
+
+    static std::size_t pop()
+    {
+        uint64_t old, head;
+        do
+        {
+            old = pool_.head;
+            const uint32_t idx = static_cast< uint32_t >( old);
+            if ( 0 == idx) return N;
+            head = ( ( old >> 32) + 1) << 32 | pool_.next[idx - 1];
+        }
+        while ( ! __sync_bool_compare_and_swap( & pool_.head, old, head) );
+        return static_cast< uint32_t >( old) - 1;
+    }
+
+    static void push( std::size_t idx)
+    {
+        uint64_t old, head;
+        do
+        {
+            old = pool_.head;
+            pool_.next[idx] = static_cast< uint32_t >( old);
+            head = ( ( old >> 32) + 1) << 32 | ( idx + 1);
+        }
+        while ( ! __sync_bool_compare_and_swap( & pool_.head, old, head) );
+    }
+
+public:
+    static bool is_stack_unbound()
+    { return false; }
+
+    static std::size_t default_stacksize()
+    { return Size; }
+
+    static std::size_t minimum_stacksize()
+    { return Size; }
+
+    static std::size_t maximum_stacksize()
+    { return Size; }
+
+    // number of stacks of the pool
+    static std::size_t capacity()
+    { return N; }
+
+    // number of stacks not in use
+    static std::size_t available()
+    { return N - pool_.used; }
+
+    void allocate( stack_context & ctx, std::size_t size)
+    {
+        BOOST_ASSERT( maximum_stacksize() >= size);
+
+        std::size_t idx = pop();
+        if ( N == idx)
+        {
+            uint32_t unused;
+            do
+            {
+                unused = pool_.unused;
+                if ( N == unused) throw stack_pool_exhausted();
+            }
+            while ( ! __sync_bool_compare_and_swap( & pool_.unused, unused, unused + 1) );
+            idx = unused;
+            if ( ! protect( idx) )
+            {
+                // the slot is returned unless another slot was taken meanwhile
+                __sync_bool_compare_and_swap( & pool_.unused, unused + 1, unused);
+                throw std::bad_alloc();
+            }
+        }
+        __sync_add_and_fetch( & pool_.used, 1);
+
+        ctx.size = slot;
+        ctx.sp = pool_.storage + ( idx + 1) * slot;
+    }
+
+    void deallocate( stack_context & ctx)
+    {
+        BOOST_ASSERT( ctx.sp);
+        BOOST_ASSERT( pool_.storage < ctx.sp && ctx.sp <= pool_.storage + N * slot);
+
+        const std::size_t idx( ( static_cast< char * >( ctx.sp) - pool_.storage) / slot - 1);
+        BOOST_ASSERT( pool_.storage + ( idx + 1) * slot == ctx.sp);
+        __sync_sub_and_fetch( & pool_.used, 1);
+        push( idx);
+    }
+};
+
+template< std::size_t N, std::size_t Size, bool Guard >
+typename static_stack_pool< N, Size, Guard >::pool static_stack_pool< N, Size, Guard >::pool_;
+
+// naming a stack would split the mapping of the static data
+template< std::size_t N, std::size_t Size, bool Guard >
+bool labels_stacks( static_stack_pool< N, Size, Guard > const&)
+{ return false; }
+#endif
+
+}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_COROUTINES_STATIC_STACK_POOL_H
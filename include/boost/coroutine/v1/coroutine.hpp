@@ -23,6 +23,7 @@
 #include <boost/utility/result_of.hpp>
 
 #include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/detail/allocate_object.hpp>
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/detail/coroutine_context.hpp>
 #include <boost/coroutine/stack_allocator.hpp>
@@ -140,10 +141,11 @@ private:
                 Signature, Allocator
         >                               caller_t;
         typename caller_t::allocator_t a( alloc);
+        detail::object_allocation< typename caller_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
+            block.commit( ::new( block.get() ) caller_t(
+                callee, unwind, preserve_fpu, a) ) );
     }
 
 public:
@@ -197,9 +199,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename StackAllocator >
@@ -228,9 +231,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename StackAllocator, typename Allocator >
@@ -258,9 +262,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 #endif
     template< typename Fn >
@@ -296,9 +301,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -333,9 +339,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -369,9 +376,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 #else
     template< typename Fn >
@@ -407,9 +415,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -444,9 +453,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -480,9 +490,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn >
@@ -518,9 +529,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -555,9 +567,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -591,9 +604,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 #endif
 
@@ -686,10 +700,11 @@ private:
                 Signature, Allocator
             >                               caller_t;
         typename caller_t::allocator_t a( alloc);
+        detail::object_allocation< typename caller_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
+            block.commit( ::new( block.get() ) caller_t(
+                callee, unwind, preserve_fpu, a) ) );
     }
 
 public:
@@ -744,9 +759,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 
     explicit coroutine( coroutine_fn fn, arguments arg, attributes const& attr = attributes(),
@@ -775,9 +791,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), arg, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), arg, attr, stack_alloc, a) ) );
     }
 
     template< typename StackAllocator >
@@ -806,9 +823,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename StackAllocator, typename Allocator >
@@ -836,9 +854,10 @@ public:
                 function_traits< Signature >::arity
         >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) ) );
     }
 #endif
     template< typename Fn >
@@ -874,9 +893,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename Fn >
@@ -912,9 +932,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -949,9 +970,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -986,9 +1008,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1022,9 +1045,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1058,9 +1082,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), arg, attr, stack_alloc, a) ) );
     }
 #else
     template< typename Fn >
@@ -1096,9 +1121,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn >
@@ -1134,9 +1160,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, arg, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, arg, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1171,9 +1198,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1207,9 +1235,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn >
@@ -1245,9 +1274,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1282,9 +1312,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1318,9 +1349,10 @@ public:
                 function_traits< Signature >::arity
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::object_allocation< typename object_t::allocator_t > block( a);
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a) ) );
     }
 #endif
 
@@ -18,6 +18,7 @@
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/detail/coroutine_context.hpp>
 #include <boost/coroutine/detail/flags.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
 #include <boost/coroutine/v1/detail/coroutine_base_resume.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -54,12 +55,30 @@ private:
     coroutine_context   callee_;
     int                 flags_;
     exception_ptr       except_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
 
 protected:
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     coroutine_base( coroutine_context::ctx_fn fn, stack_context * stack_ctx,
+                    copy_stack * copy, bool signal_stack,
                     bool unwind, bool preserve_fpu) :
         coroutine_base_resume<
             Signature,
@@ -69,12 +88,15 @@ public:
         >(),
         use_count_( 0),
         caller_(),
-        callee_( fn, stack_ctx),
+        callee_( fn, stack_ctx, copy),
         flags_( 0),
-        except_()
+        except_(),
+        copy_( copy)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     coroutine_base( coroutine_context const& callee, bool unwind, bool preserve_fpu) :
@@ -88,7 +110,8 @@ public:
         caller_(),
         callee_( callee),
         flags_( 0),
-        except_()
+        except_(),
+        copy_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
@@ -46,10 +46,8 @@ public:
         holder< void > hldr_to( & static_cast< D * >( this)->caller_);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                hldr_to.ctx->jump(
-                    static_cast< D * >( this)->callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    static_cast< D * >( this)->preserve_fpu() ) ) );
+                static_cast< D * >( this)->resume_(
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         static_cast< D * >( this)->callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -70,13 +68,11 @@ public:
         holder< void > hldr_to( & static_cast< D * >( this)->caller_);
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                hldr_to.ctx->jump(
-                    static_cast< D * >( this)->callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    static_cast< D * >( this)->preserve_fpu() ) ) );
+                static_cast< D * >( this)->resume_(
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         static_cast< D * >( this)->callee_ = * hldr_from->ctx;
-        result_ = hldr_from->data;
+        hldr_from->transfer( result_);
         if ( hldr_from->force_unwind) throw forced_unwind();
         if ( static_cast< D * >( this)->except_)
             rethrow_exception( static_cast< D * >( this)->except_);
@@ -103,10 +99,8 @@ public:
         holder< arg_type > hldr_to( & static_cast< D * >( this)->caller_, a1);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                hldr_to.ctx->jump(
-                    static_cast< D * >( this)->callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    static_cast< D * >( this)->preserve_fpu() ) ) );
+                static_cast< D * >( this)->resume_(
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         static_cast< D * >( this)->callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -130,13 +124,11 @@ public:
         holder< arg_type > hldr_to( & static_cast< D * >( this)->caller_, a1);
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                hldr_to.ctx->jump(
-                    static_cast< D * >( this)->callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    static_cast< D * >( this)->preserve_fpu() ) ) );
+                static_cast< D * >( this)->resume_(
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         static_cast< D * >( this)->callee_ = * hldr_from->ctx;
-        result_ = hldr_from->data;
+        hldr_from->transfer( result_);
         if ( hldr_from->force_unwind) throw forced_unwind();
         if ( static_cast< D * >( this)->except_)
             rethrow_exception( static_cast< D * >( this)->except_);
@@ -168,15 +160,12 @@ public: \
         BOOST_ASSERT( static_cast< D * >( this)); \
         BOOST_ASSERT( ! static_cast< D * >( this)->is_complete() ); \
 \
-        holder< arg_type > hldr_to( \
-            & static_cast< D * >( this)->caller_, \
-            arg_type(BOOST_COROUTINE_BASE_RESUME_VALS(n) ) ); \
+        arg_type args( BOOST_COROUTINE_BASE_RESUME_VALS(n) ); \
+        holder< arg_type > hldr_to( & static_cast< D * >( this)->caller_, args); \
         holder< void > * hldr_from( \
             reinterpret_cast< holder< void > * >( \
-                hldr_to.ctx->jump( \
-                    static_cast< D * >( this)->callee_, \
-                    reinterpret_cast< intptr_t >( & hldr_to), \
-                    static_cast< D * >( this)->preserve_fpu() ) ) ); \
+                static_cast< D * >( this)->resume_( \
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) ); \
         BOOST_ASSERT( hldr_from->ctx); \
         static_cast< D * >( this)->callee_ = * hldr_from->ctx; \
         if ( hldr_from->force_unwind) throw forced_unwind(); \
@@ -196,18 +185,15 @@ public: \
         BOOST_ASSERT( static_cast< D * >( this)); \
         BOOST_ASSERT( ! static_cast< D * >( this)->is_complete() ); \
 \
-        holder< arg_type > hldr_to( \
-            & static_cast< D * >( this)->caller_, \
-            arg_type(BOOST_COROUTINE_BASE_RESUME_VALS(n) ) ); \
+        arg_type args( BOOST_COROUTINE_BASE_RESUME_VALS(n) ); \
+        holder< arg_type > hldr_to( & static_cast< D * >( this)->caller_, args); \
         holder< Result > * hldr_from( \
             reinterpret_cast< holder< Result > * >( \
-                hldr_to.ctx->jump( \
-                    static_cast< D * >( this)->callee_, \
-                    reinterpret_cast< intptr_t >( & hldr_to), \
-                    static_cast< D * >( this)->preserve_fpu() ) ) ); \
+                static_cast< D * >( this)->resume_( \
+                    reinterpret_cast< intptr_t >( & hldr_to) ) ) ); \
         BOOST_ASSERT( hldr_from->ctx); \
         static_cast< D * >( this)->callee_ = * hldr_from->ctx; \
-        result_ = hldr_from->data; \
+        hldr_from->transfer( result_); \
         if ( hldr_from->force_unwind) throw forced_unwind(); \
         if ( static_cast< D * >( this)->except_) \
             rethrow_exception( static_cast< D * >( this)->except_); \
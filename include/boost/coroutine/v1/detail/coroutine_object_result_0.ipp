@@ -41,12 +41,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -56,10 +53,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -70,10 +64,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -83,10 +77,10 @@ public:
     coroutine_object( Fn fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -96,10 +90,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -179,12 +173,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -194,10 +185,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -207,10 +195,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -289,12 +277,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -304,10 +289,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -317,10 +299,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
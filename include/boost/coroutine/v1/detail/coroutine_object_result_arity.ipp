@@ -42,12 +42,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -58,12 +55,9 @@ private:
         > tpl( this, arg);
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -73,10 +67,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -87,10 +78,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -100,10 +91,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -113,10 +104,10 @@ public:
     coroutine_object( Fn fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -126,10 +117,10 @@ public:
     coroutine_object( Fn fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -139,10 +130,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -152,10 +143,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -262,12 +253,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -278,12 +266,9 @@ private:
         > tpl( this, arg);
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -293,10 +278,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -306,10 +288,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -319,10 +301,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -428,12 +410,9 @@ private:
     {
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -444,12 +423,9 @@ private:
         > tpl( this, arg);
         holder< Result > * hldr_from(
             reinterpret_cast< holder< Result > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -459,10 +435,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -472,10 +445,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -485,10 +458,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
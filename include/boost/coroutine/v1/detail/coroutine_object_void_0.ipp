@@ -40,10 +40,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -54,10 +51,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -68,10 +62,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -81,10 +75,11 @@ public:
     coroutine_object( Fn fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->pbase_type::stack_ctx,
+            & this->pbase_type::stack_ctx, this->pbase_type::copy,
+            this->pbase_type::signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -94,10 +89,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -176,10 +171,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -190,10 +182,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -203,10 +192,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -284,10 +273,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -298,10 +284,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -311,10 +294,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
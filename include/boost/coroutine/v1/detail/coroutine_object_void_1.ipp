@@ -41,10 +41,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -56,10 +53,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -70,10 +64,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -84,10 +75,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -97,10 +88,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -110,10 +101,10 @@ public:
     coroutine_object( Fn fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -123,10 +114,10 @@ public:
     coroutine_object( Fn fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -136,10 +127,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -149,10 +140,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -258,10 +249,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -273,10 +261,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -287,10 +272,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -300,10 +282,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -314,10 +296,10 @@ public:
                       typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -422,10 +404,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -437,10 +416,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -451,10 +427,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -464,10 +437,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -478,10 +451,10 @@ public:
                       typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
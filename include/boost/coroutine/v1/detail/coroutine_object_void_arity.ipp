@@ -42,10 +42,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -57,10 +54,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -71,10 +65,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -85,10 +76,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -98,10 +89,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -111,10 +102,10 @@ public:
     coroutine_object( Fn fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -124,10 +115,10 @@ public:
     coroutine_object( Fn fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -137,10 +128,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -150,10 +141,10 @@ public:
     coroutine_object( BOOST_RV_REF( Fn) fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -260,10 +251,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -275,10 +263,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -289,10 +274,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -302,10 +284,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -315,10 +297,10 @@ public:
     coroutine_object( reference_wrapper< Fn > fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -424,10 +406,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -439,10 +418,7 @@ private:
         > tpl( this, arg);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( & tpl),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( & tpl) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -453,10 +429,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< arg_type > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -466,10 +439,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline1< coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -479,10 +452,10 @@ public:
     coroutine_object( const reference_wrapper< Fn > fn, typename detail::param< arg_type >::type arg, attributes const& attr,
                       StackAllocator const& stack_alloc,
                       allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), 0),
         base_type(
             trampoline2< coroutine_object, typename detail::param< arg_type >::type >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
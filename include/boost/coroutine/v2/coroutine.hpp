@@ -24,6 +24,7 @@
 #include <boost/utility/enable_if.hpp>
 
 #include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/detail/allocate_object.hpp>
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/detail/coroutine_context.hpp>
 #include <boost/coroutine/detail/param.hpp>
@@ -57,6 +58,7 @@ private:
 
     typedef detail::push_coroutine_base< Arg >  base_t;
     typedef typename base_t::ptr_t              ptr_t;
+    typedef detail::push_coroutine_caller< Arg >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -67,21 +69,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( push_coroutine)
 
-    template< typename Allocator >
-    push_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc) :
-        impl_()
-    {
-        typedef detail::push_coroutine_caller<
-                Arg, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit push_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     push_coroutine() BOOST_NOEXCEPT :
@@ -235,6 +227,13 @@ public:
     void swap( push_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     push_coroutine & operator()( Arg const& arg)
     {
@@ -247,7 +246,7 @@ public:
     push_coroutine & operator()( Arg && arg) {
         BOOST_ASSERT( * this);
 
-        impl_->push( arg);
+        impl_->push( boost::move( arg) );
         return * this;
     }
 #else
@@ -316,6 +315,7 @@ private:
 
     typedef detail::push_coroutine_base< Arg & >    base_t;
     typedef typename base_t::ptr_t                  ptr_t;
+    typedef detail::push_coroutine_caller< Arg & >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -326,21 +326,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( push_coroutine)
 
-    template< typename Allocator >
-    push_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc) :
-        impl_()
-    {
-        typedef detail::push_coroutine_caller<
-                Arg &, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit push_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     push_coroutine() BOOST_NOEXCEPT :
@@ -494,6 +484,13 @@ public:
     void swap( push_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
     push_coroutine & operator()( Arg & arg)
     {
         BOOST_ASSERT( * this);
@@ -550,6 +547,7 @@ private:
 
     typedef detail::push_coroutine_base< void >  base_t;
     typedef base_t::ptr_t                        ptr_t;
+    typedef detail::push_coroutine_caller< void >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -560,21 +558,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( push_coroutine)
 
-    template< typename Allocator >
-    push_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc) :
-        impl_()
-    {
-        typedef detail::push_coroutine_caller<
-                void, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit push_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     push_coroutine() BOOST_NOEXCEPT :
@@ -728,6 +716,13 @@ public:
     void swap( push_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
     push_coroutine & operator()()
     {
         BOOST_ASSERT( * this);
@@ -753,6 +748,7 @@ private:
 
     typedef detail::pull_coroutine_base< R >    base_t;
     typedef typename base_t::ptr_t              ptr_t;
+    typedef detail::pull_coroutine_caller< R >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -763,22 +759,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( pull_coroutine)
 
-    template< typename Allocator >
-    pull_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc,
-                    optional< R > const& result) :
-        impl_()
-    {
-        typedef detail::pull_coroutine_caller<
-                R, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a, result) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit pull_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     pull_coroutine() BOOST_NOEXCEPT :
@@ -805,9 +790,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator >
@@ -826,9 +812,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator, typename Allocator >
@@ -846,9 +833,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
     template< typename Fn >
@@ -868,9 +856,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -889,9 +878,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -909,9 +899,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #else
     template< typename Fn >
@@ -931,9 +922,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -952,9 +944,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -972,9 +965,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn >
@@ -994,9 +988,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1015,9 +1010,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1035,9 +1031,10 @@ public:
                 push_coroutine< R >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
 
@@ -1064,6 +1061,13 @@ public:
     void swap( pull_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
     pull_coroutine & operator()()
     {
         BOOST_ASSERT( * this);
@@ -1274,6 +1278,7 @@ private:
 
     typedef detail::pull_coroutine_base< R & >  base_t;
     typedef typename base_t::ptr_t              ptr_t;
+    typedef detail::pull_coroutine_caller< R & >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -1284,22 +1289,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( pull_coroutine)
 
-    template< typename Allocator >
-    pull_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc,
-                    optional< R * > const& result) :
-        impl_()
-    {
-        typedef detail::pull_coroutine_caller<
-                R &, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a, result) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit pull_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     pull_coroutine() BOOST_NOEXCEPT :
@@ -1326,9 +1320,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator >
@@ -1347,9 +1342,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator, typename Allocator >
@@ -1367,9 +1363,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
     template< typename Fn >
@@ -1389,9 +1386,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1410,9 +1408,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1430,9 +1429,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #else
     template< typename Fn >
@@ -1452,9 +1452,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1473,9 +1474,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1493,9 +1495,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn >
@@ -1515,9 +1518,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1536,9 +1540,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1556,9 +1561,10 @@ public:
                 push_coroutine< R & >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
 
@@ -1585,6 +1591,13 @@ public:
     void swap( pull_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
     pull_coroutine & operator()()
     {
         BOOST_ASSERT( * this);
@@ -1791,6 +1804,7 @@ private:
 
     typedef detail::pull_coroutine_base< void > base_t;
     typedef base_t::ptr_t                       ptr_t;
+    typedef detail::pull_coroutine_caller< void >  caller_t;
 
     struct dummy
     { void nonnull() {} };
@@ -1801,21 +1815,11 @@ private:
 
     BOOST_MOVABLE_BUT_NOT_COPYABLE( pull_coroutine)
 
-    template< typename Allocator >
-    pull_coroutine( detail::coroutine_context const& callee,
-                    bool unwind, bool preserve_fpu,
-                    Allocator const& alloc) :
-        impl_()
-    {
-        typedef detail::pull_coroutine_caller<
-                void, Allocator
-        >                               caller_t;
-        typename caller_t::allocator_t a( alloc);
-        impl_ = ptr_t(
-            // placement new
-            ::new( a.allocate( 1) ) caller_t(
-                callee, unwind, preserve_fpu, a) );
-    }
+    // the caller side of the coroutine-function, constructed by run() of the
+    // coroutine on its stack
+    explicit pull_coroutine( caller_t * impl) :
+        impl_( impl)
+    {}
 
 public:
     pull_coroutine() BOOST_NOEXCEPT :
@@ -1842,9 +1846,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator >
@@ -1863,9 +1868,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename StackAllocator, typename Allocator >
@@ -1883,9 +1889,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
     template< typename Fn >
@@ -1905,9 +1912,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1926,9 +1934,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -1946,9 +1955,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
     }
 #else
     template< typename Fn >
@@ -1968,9 +1978,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -1989,9 +2000,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -2009,9 +2021,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn >
@@ -2031,9 +2044,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator >
@@ -2052,9 +2066,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 
     template< typename Fn, typename StackAllocator, typename Allocator >
@@ -2072,9 +2087,10 @@ public:
                 push_coroutine< void >
             >                               object_t;
         typename object_t::allocator_t a( alloc);
+        detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
         impl_ = ptr_t(
             // placement new
-            ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+            block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
     }
 #endif
 
@@ -2101,6 +2117,13 @@ public:
     void swap( pull_coroutine & other) BOOST_NOEXCEPT
     { impl_.swap( other.impl_); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( * this);
+
+        return impl_->hibernate();
+    }
+
     pull_coroutine & operator()()
     {
         BOOST_ASSERT( * this);
@@ -2131,9 +2154,10 @@ push_coroutine< Arg >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2152,9 +2176,10 @@ push_coroutine< Arg >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2173,9 +2198,10 @@ push_coroutine< Arg >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2193,9 +2219,10 @@ push_coroutine< Arg & >::push_coroutine( coroutine_fn fn, attributes const& attr
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2214,9 +2241,10 @@ push_coroutine< Arg & >::push_coroutine( coroutine_fn fn, attributes const& attr
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2235,9 +2263,10 @@ push_coroutine< Arg & >::push_coroutine( coroutine_fn fn, attributes const& attr
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 push_coroutine< void >::push_coroutine( coroutine_fn fn, attributes const& attr,
@@ -2254,9 +2283,10 @@ push_coroutine< void >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename StackAllocator >
@@ -2274,9 +2304,10 @@ push_coroutine< void >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename StackAllocator, typename Allocator >
@@ -2294,9 +2325,10 @@ push_coroutine< void >::push_coroutine( coroutine_fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< coroutine_fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 #endif
 template< typename Arg >
@@ -2315,9 +2347,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2336,9 +2369,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2357,9 +2391,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2378,9 +2413,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2399,9 +2435,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2420,9 +2457,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn >
@@ -2440,9 +2478,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator >
@@ -2460,9 +2499,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator, typename Allocator >
@@ -2480,9 +2520,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( forward< Fn >( fn), attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( forward< Fn >( fn), attr, stack_alloc, a, block.stack() ) ) );
 }
 #else
 template< typename Arg >
@@ -2501,9 +2542,10 @@ push_coroutine< Arg >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2522,9 +2564,10 @@ push_coroutine< Arg >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2543,9 +2586,10 @@ push_coroutine< Arg >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2564,9 +2608,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2585,9 +2630,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2606,9 +2652,10 @@ push_coroutine< Arg >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const& a
             pull_coroutine< Arg >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2627,9 +2674,10 @@ push_coroutine< Arg & >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2648,9 +2696,10 @@ push_coroutine< Arg & >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2669,9 +2718,10 @@ push_coroutine< Arg & >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2690,9 +2740,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2711,9 +2762,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Arg >
@@ -2732,9 +2784,10 @@ push_coroutine< Arg & >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< Arg & >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn >
@@ -2752,9 +2805,10 @@ push_coroutine< void >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator >
@@ -2772,9 +2826,10 @@ push_coroutine< void >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator, typename Allocator >
@@ -2792,9 +2847,10 @@ push_coroutine< void >::push_coroutine( Fn fn, attributes const& attr,
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn >
@@ -2812,9 +2868,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator >
@@ -2832,9 +2889,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 
 template< typename Fn, typename StackAllocator, typename Allocator >
@@ -2852,9 +2910,10 @@ push_coroutine< void >::push_coroutine( BOOST_RV_REF( Fn) fn, attributes const&
             pull_coroutine< void >
         >                               object_t;
     typename object_t::allocator_t a( alloc);
+    detail::control_allocation< object_t > block( a, attr, stack_alloc, detail::site_address( fn) );
     impl_ = ptr_t(
         // placement new
-        ::new( a.allocate( 1) ) object_t( fn, attr, stack_alloc, a) );
+        block.commit( ::new( block.get() ) object_t( fn, attr, stack_alloc, a, block.stack() ) ) );
 }
 #endif
 
@@ -22,7 +22,9 @@
 #include <boost/coroutine/detail/flags.hpp>
 #include <boost/coroutine/detail/holder.hpp>
 #include <boost/coroutine/detail/param.hpp>
+#include <boost/coroutine/detail/stack_image.hpp>
 #include <boost/coroutine/exceptions.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -54,41 +56,75 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
     optional< R >       result_;
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     pull_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx),
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0),
         result_()
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     pull_coroutine_base( coroutine_context const& callee,
                          bool unwind, bool preserve_fpu,
-                         optional< R > const& result) :
+                         holder< R > const& from) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
         callee_( callee),
-        result_( result)
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0),
+        result_()
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        from.transfer( result_);
     }
 
     virtual ~pull_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -102,6 +138,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( pull_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -115,13 +161,10 @@ public:
         holder< R > hldr_to( & caller_);
         holder< R > * hldr_from(
             reinterpret_cast< holder< R > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
-        result_ = hldr_from->data;
+        hldr_from->transfer( result_);
         if ( hldr_from->force_unwind) throw forced_unwind();
         if ( except_) rethrow_exception( except_);
     }
@@ -157,41 +200,75 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
     optional< R * >     result_;
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     pull_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx),
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0),
         result_()
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     pull_coroutine_base( coroutine_context const& callee,
                          bool unwind, bool preserve_fpu,
-                         optional< R * > const& result) :
+                         holder< R * > const& from) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
         callee_( callee),
-        result_( result)
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0),
+        result_()
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        from.transfer( result_);
     }
 
     virtual ~pull_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -205,6 +282,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( pull_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -215,16 +302,13 @@ public:
     {
         BOOST_ASSERT( ! is_complete() );
 
-        holder< R & > hldr_to( & caller_);
-        holder< R & > * hldr_from(
-            reinterpret_cast< holder< R & > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+        holder< R * > hldr_to( & caller_);
+        holder< R * > * hldr_from(
+            reinterpret_cast< holder< R * > * >(
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
-        result_ = hldr_from->data;
+        hldr_from->transfer( result_);
         if ( hldr_from->force_unwind) throw forced_unwind();
         if ( except_) rethrow_exception( except_);
     }
@@ -260,21 +344,51 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     pull_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx)
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     pull_coroutine_base( coroutine_context const& callee,
@@ -283,14 +397,17 @@ public:
         flags_( 0),
         except_(),
         caller_(),
-        callee_( callee)
+        callee_( callee),
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
     }
 
     virtual ~pull_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -304,6 +421,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( pull_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -317,10 +444,7 @@ public:
         holder< void > hldr_to( & caller_);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -8,9 +8,9 @@
 
 #include <boost/config.hpp>
 #include <boost/context/fcontext.hpp>
-#include <boost/optional.hpp>
 
 #include <boost/coroutine/detail/config.hpp>
+#include <boost/coroutine/detail/holder.hpp>
 #include <boost/coroutine/v2/detail/pull_coroutine_base.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -21,85 +21,45 @@ namespace boost {
 namespace coroutines {
 namespace detail {
 
-template< typename R, typename Allocator >
+template< typename R >
 class pull_coroutine_caller : public  pull_coroutine_base< R >
 {
 public:
-    typedef typename Allocator::template rebind<
-        pull_coroutine_caller< R, Allocator >
-    >::other   allocator_t;
-
     pull_coroutine_caller( coroutine_context const& callee, bool unwind, bool preserve_fpu,
-                           allocator_t const& alloc, optional< R > const& data) BOOST_NOEXCEPT :
-        pull_coroutine_base< R >( callee, unwind, preserve_fpu, data),
-        alloc_( alloc)
+                           holder< R > const& from) :
+        pull_coroutine_base< R >( callee, unwind, preserve_fpu, from)
     {}
 
+    // lives in the frame of run() on the stack of the coroutine, destroyed there
     void deallocate_object()
-    { destroy_( alloc_, this); }
-
-private:
-    allocator_t   alloc_;
-
-    static void destroy_( allocator_t & alloc, pull_coroutine_caller * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    {}
 };
 
-template< typename R, typename Allocator >
-class pull_coroutine_caller< R &, Allocator > : public  pull_coroutine_base< R & >
+template< typename R >
+class pull_coroutine_caller< R & > : public  pull_coroutine_base< R & >
 {
 public:
-    typedef typename Allocator::template rebind<
-        pull_coroutine_caller< R &, Allocator >
-    >::other   allocator_t;
-
     pull_coroutine_caller( coroutine_context const& callee, bool unwind, bool preserve_fpu,
-                           allocator_t const& alloc, optional< R * > const& data) BOOST_NOEXCEPT :
-        pull_coroutine_base< R & >( callee, unwind, preserve_fpu, data),
-        alloc_( alloc)
+                           holder< R * > const& from) :
+        pull_coroutine_base< R & >( callee, unwind, preserve_fpu, from)
     {}
 
+    // lives in the frame of run() on the stack of the coroutine, destroyed there
     void deallocate_object()
-    { destroy_( alloc_, this); }
-
-private:
-    allocator_t   alloc_;
-
-    static void destroy_( allocator_t & alloc, pull_coroutine_caller * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    {}
 };
 
-template< typename Allocator >
-class pull_coroutine_caller< void, Allocator > : public  pull_coroutine_base< void >
+template<>
+class pull_coroutine_caller< void > : public  pull_coroutine_base< void >
 {
 public:
-    typedef typename Allocator::template rebind<
-        pull_coroutine_caller< void, Allocator >
-    >::other   allocator_t;
-
-    pull_coroutine_caller( coroutine_context const& callee, bool unwind, bool preserve_fpu,
-                           allocator_t const& alloc) BOOST_NOEXCEPT :
-        pull_coroutine_base< void >( callee, unwind, preserve_fpu),
-        alloc_( alloc)
+    pull_coroutine_caller( coroutine_context const& callee, bool unwind, bool preserve_fpu) BOOST_NOEXCEPT :
+        pull_coroutine_base< void >( callee, unwind, preserve_fpu)
     {}
 
+    // lives in the frame of run() on the stack of the coroutine, destroyed there
     void deallocate_object()
-    { destroy_( alloc_, this); }
-
-private:
-    allocator_t   alloc_;
-
-    static void destroy_( allocator_t & alloc, pull_coroutine_caller * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    {}
 };
 
 }}}
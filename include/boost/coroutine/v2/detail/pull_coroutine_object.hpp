@@ -20,6 +20,7 @@
 #include <boost/utility.hpp>
 
 #include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/detail/allocate_object.hpp>
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/exceptions.hpp>
 #include <boost/coroutine/detail/flags.hpp>
@@ -67,10 +68,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -79,12 +77,9 @@ private:
     {
         holder< R > * hldr_from(
             reinterpret_cast< holder< R > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -94,10 +89,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -107,11 +99,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     pull_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -120,11 +113,12 @@ public:
 #else
     pull_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -133,11 +127,12 @@ public:
 
     pull_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -158,7 +153,8 @@ public:
 
         {
             // create push_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -205,10 +201,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -217,10 +210,7 @@ private:
     {
         holder< R > * hldr_from(
             reinterpret_cast< holder< R > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -231,10 +221,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -243,11 +230,12 @@ private:
 public:
     pull_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -267,7 +255,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -314,10 +303,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -326,10 +312,7 @@ private:
     {
         holder< R > * hldr_from(
             reinterpret_cast< holder< R > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -340,10 +323,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -352,11 +332,12 @@ private:
 public:
     pull_coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -376,7 +357,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -423,10 +405,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -435,12 +414,9 @@ private:
     {
         holder< R * > * hldr_from(
             reinterpret_cast< holder< R * > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
-        this->result_ = hldr_from->data;
+        hldr_from->transfer( this->result_);
         if ( this->except_) rethrow_exception( this->except_);
     }
 
@@ -450,10 +426,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -463,11 +436,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     pull_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -476,11 +450,12 @@ public:
 #else
     pull_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -489,11 +464,12 @@ public:
 
     pull_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -514,7 +490,8 @@ public:
 
         {
             // create push_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -561,10 +538,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -573,10 +547,7 @@ private:
     {
         holder< R * > * hldr_from(
             reinterpret_cast< holder< R * > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -587,10 +558,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -599,11 +567,12 @@ private:
 public:
     pull_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -623,7 +592,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -670,10 +640,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -682,10 +649,7 @@ private:
     {
         holder< R * > * hldr_from(
             reinterpret_cast< holder< R * > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -696,10 +660,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< R * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -708,11 +669,12 @@ private:
 public:
     pull_coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -732,7 +694,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -779,10 +742,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -791,10 +751,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -805,10 +762,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -818,11 +772,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     pull_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -831,11 +786,12 @@ public:
 #else
     pull_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -844,11 +800,12 @@ public:
 
     pull_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -869,7 +826,8 @@ public:
 
         {
             // create push_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -916,10 +874,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -928,10 +883,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -942,10 +894,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -954,11 +903,12 @@ private:
 public:
     pull_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -978,7 +928,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -1025,10 +976,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, pull_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     pull_coroutine_object( pull_coroutine_object &);
     pull_coroutine_object & operator=( pull_coroutine_object const&);
@@ -1037,10 +985,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -1051,10 +996,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -1064,11 +1006,12 @@ public:
     pull_coroutine_object( const reference_wrapper< Fn > fn,
                            attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< pull_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -1088,7 +1031,8 @@ public:
 
         {
             // create pull_coroutine
-            Caller c( this->caller_, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( this->caller_, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
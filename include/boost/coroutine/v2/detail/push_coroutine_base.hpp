@@ -12,13 +12,16 @@
 #include <boost/context/fcontext.hpp>
 #include <boost/exception_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
+#include <boost/move/move.hpp>
 #include <boost/type_traits/function_traits.hpp>
 #include <boost/utility.hpp>
 
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/detail/coroutine_context.hpp>
 #include <boost/coroutine/exceptions.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
 #include <boost/coroutine/detail/flags.hpp>
+#include <boost/coroutine/detail/holder.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -50,21 +53,51 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     push_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx)
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     push_coroutine_base( coroutine_context const& callee,
@@ -73,14 +106,17 @@ public:
         flags_( 0),
         except_(),
         caller_(),
-        callee_( callee)
+        callee_( callee),
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
     }
 
     virtual ~push_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -94,6 +130,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( push_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -108,10 +154,7 @@ public:
         holder< Arg > hldr_to( & caller_, arg);
         holder< Arg > * hldr_from(
             reinterpret_cast< holder< Arg > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -122,13 +165,10 @@ public:
     {
         BOOST_ASSERT( ! is_complete() );
 
-        holder< Arg > hldr_to( & caller_, boost::forward( arg) );
+        holder< Arg > hldr_to( & caller_, boost::move( arg) );
         holder< Arg > * hldr_from(
             reinterpret_cast< holder< Arg > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -142,10 +182,7 @@ public:
         holder< Arg > hldr_to( & caller_, arg);
         holder< Arg > * hldr_from(
             reinterpret_cast< holder< Arg > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -159,10 +196,7 @@ public:
         holder< Arg > hldr_to( & caller_, arg);
         holder< Arg > * hldr_from(
             reinterpret_cast< holder< Arg > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -190,21 +224,51 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     push_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx)
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     push_coroutine_base( coroutine_context const& callee,
@@ -213,14 +277,17 @@ public:
         flags_( 0),
         except_(),
         caller_(),
-        callee_( callee)
+        callee_( callee),
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
     }
 
     virtual ~push_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -234,6 +301,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( push_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -244,13 +321,11 @@ public:
     {
         BOOST_ASSERT( ! is_complete() );
 
-        holder< Arg * > hldr_to( & caller_, & arg);
+        Arg * p( & arg);
+        holder< Arg * > hldr_to( & caller_, p);
         holder< Arg * > * hldr_from(
             reinterpret_cast< holder< Arg * > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -277,21 +352,51 @@ protected:
     exception_ptr       except_;
     coroutine_context   caller_;
     coroutine_context   callee_;
+    stack_context   *   stack_ctx_;
+    copy_stack      *   copy_;      // shared stack the coroutine runs on
+    stack_image     *   image_;     // used part of the stack while hibernated
 
     virtual void deallocate_object() = 0;
 
+    // resumes the coroutine, `param` is passed to it
+    intptr_t resume_( intptr_t param)
+    {
+        if ( 0 == ( flags_ & ( flag_signal_stack | flag_shared_stack | flag_hibernated) ) )
+            return caller_.jump( callee_, param, preserve_fpu() );
+
+        if ( 0 != ( flags_ & flag_hibernated) )
+        {
+            restore_stack( image_);
+            image_ = 0;
+            flags_ &= ~flag_hibernated;
+        }
+#if ! defined(BOOST_WINDOWS)
+        // a fault growing the stack is handled on the alternate signal stack
+        // of the resuming thread
+        if ( 0 != ( flags_ & flag_signal_stack) ) prepare_signal_stack();
+        if ( 0 != ( flags_ & flag_shared_stack) )
+            return caller_.jump_copy_stack( callee_, copy_, param, preserve_fpu() );
+#endif
+        return caller_.jump( callee_, param, preserve_fpu() );
+    }
+
 public:
     push_coroutine_base( coroutine_context::ctx_fn fn,
-                         stack_context * stack_ctx,
-                         bool unwind, bool preserve_fpu) :
+                         stack_context * stack_ctx, copy_stack * copy,
+                         bool signal_stack, bool unwind, bool preserve_fpu) :
         use_count_( 0),
         flags_( 0),
         except_(),
         caller_(),
-        callee_( fn, stack_ctx)
+        callee_( fn, stack_ctx, copy),
+        stack_ctx_( stack_ctx),
+        copy_( copy),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
+        if ( signal_stack) flags_ |= flag_signal_stack;
+        if ( copy) flags_ |= flag_shared_stack;
     }
 
     push_coroutine_base( coroutine_context const& callee,
@@ -300,14 +405,17 @@ public:
         flags_( 0),
         except_(),
         caller_(),
-        callee_( callee)
+        callee_( callee),
+        stack_ctx_( 0),
+        copy_( 0),
+        image_( 0)
     {
         if ( unwind) flags_ |= flag_force_unwind;
         if ( preserve_fpu) flags_ |= flag_preserve_fpu;
     }
 
     virtual ~push_coroutine_base()
-    {}
+    { destroy_stack_image( image_); }
 
     bool force_unwind() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_force_unwind); }
@@ -321,6 +429,16 @@ public:
     bool is_complete() const BOOST_NOEXCEPT
     { return 0 != ( flags_ & flag_complete); }
 
+    bool hibernate()
+    {
+        BOOST_ASSERT( ! is_complete() );
+
+        if ( ! image_) image_ = callee_.hibernate( stack_ctx_);
+        if ( ! image_) return false;
+        flags_ |= flag_hibernated;
+        return true;
+    }
+
     friend inline void intrusive_ptr_add_ref( push_coroutine_base * p) BOOST_NOEXCEPT
     { ++p->use_count_; }
 
@@ -334,10 +452,7 @@ public:
         holder< void > hldr_to( & caller_);
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                hldr_to.ctx->jump(
-                    callee_,
-                    reinterpret_cast< intptr_t >( & hldr_to),
-                    preserve_fpu() ) ) );
+                resume_( reinterpret_cast< intptr_t >( & hldr_to) ) ) );
         BOOST_ASSERT( hldr_from->ctx);
         callee_ = * hldr_from->ctx;
         if ( hldr_from->force_unwind) throw forced_unwind();
@@ -20,31 +20,17 @@ namespace boost {
 namespace coroutines {
 namespace detail {
 
-template< typename Arg, typename Allocator >
+template< typename Arg >
 class push_coroutine_caller : public  push_coroutine_base< Arg >
 {
 public:
-    typedef typename Allocator::template rebind<
-        push_coroutine_caller< Arg, Allocator >
-    >::other   allocator_t;
-
-    push_coroutine_caller( coroutine_context const& callee, bool unwind,
-                           bool preserve_fpu, allocator_t const& alloc) BOOST_NOEXCEPT :
-        push_coroutine_base< Arg >( callee, unwind, preserve_fpu),
-        alloc_( alloc)
+    push_coroutine_caller( coroutine_context const& callee, bool unwind, bool preserve_fpu) BOOST_NOEXCEPT :
+        push_coroutine_base< Arg >( callee, unwind, preserve_fpu)
     {}
 
+    // lives in the frame of run() on the stack of the coroutine, destroyed there
     void deallocate_object()
-    { destroy_( alloc_, this); }
-
-private:
-    allocator_t   alloc_;
-
-    static void destroy_( allocator_t & alloc, push_coroutine_caller * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    {}
 };
 
 }}}
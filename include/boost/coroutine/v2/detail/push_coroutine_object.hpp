@@ -20,6 +20,7 @@
 #include <boost/utility.hpp>
 
 #include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/detail/allocate_object.hpp>
 #include <boost/coroutine/detail/config.hpp>
 #include <boost/coroutine/exceptions.hpp>
 #include <boost/coroutine/detail/flags.hpp>
@@ -67,10 +68,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -79,10 +77,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -93,10 +88,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -106,11 +98,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     push_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -119,11 +112,12 @@ public:
 #else
     push_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -132,11 +126,12 @@ public:
 
     push_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
-                      allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                      allocator_t const& alloc,
+                      embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -167,7 +162,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -214,10 +210,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -226,10 +219,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -240,10 +230,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -252,11 +239,12 @@ private:
 public:
     push_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -286,7 +274,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -333,10 +322,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -345,10 +331,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -359,10 +342,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -371,11 +351,12 @@ private:
 public:
     push_coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
-                      allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                      allocator_t const& alloc,
+                      embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -405,7 +386,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -452,10 +434,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -464,10 +443,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -478,10 +454,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -491,11 +464,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     push_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -504,11 +478,12 @@ public:
 #else
     push_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -517,11 +492,12 @@ public:
 
     push_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -552,7 +528,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -599,10 +576,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -611,10 +585,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -625,10 +596,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -637,11 +605,12 @@ private:
 public:
     push_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -671,7 +640,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -718,10 +688,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -730,10 +697,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -744,10 +708,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< Arg * > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -756,11 +717,12 @@ private:
 public:
     push_coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -790,7 +752,8 @@ public:
             BOOST_ASSERT( hldr_from->data);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_, hldr_from->data);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu(), * hldr_from);
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -837,10 +800,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -849,10 +809,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -863,10 +820,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -876,11 +830,12 @@ public:
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     push_coroutine_object( Fn && fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( forward< Fn >( fn) ),
@@ -889,11 +844,12 @@ public:
 #else
     push_coroutine_object( Fn fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -902,11 +858,12 @@ public:
 
     push_coroutine_object( BOOST_RV_REF( Fn) fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
-                      allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                      allocator_t const& alloc,
+                      embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -936,7 +893,8 @@ public:
             BOOST_ASSERT( hldr_from->ctx);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -983,10 +941,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -995,10 +950,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -1009,10 +961,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -1021,11 +970,12 @@ private:
 public:
     push_coroutine_object( reference_wrapper< Fn > fn, attributes const& attr,
                            StackAllocator const& stack_alloc,
-                           allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                           allocator_t const& alloc,
+                           embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -1054,7 +1004,8 @@ public:
             BOOST_ASSERT( hldr_from->ctx);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
@@ -1101,10 +1052,7 @@ private:
     allocator_t             alloc_;
 
     static void destroy_( allocator_t & alloc, push_coroutine_object * p)
-    {
-        alloc.destroy( p);
-        alloc.deallocate( p, 1);
-    }
+    { destroy_object( alloc, p, static_cast< pbase_type * >( p) ); }
 
     push_coroutine_object( push_coroutine_object &);
     push_coroutine_object & operator=( push_coroutine_object const&);
@@ -1113,10 +1061,7 @@ private:
     {
         holder< void > * hldr_from(
             reinterpret_cast< holder< void > * >(
-                this->caller_.jump(
-                    this->callee_,
-                    reinterpret_cast< intptr_t >( this),
-                    this->preserve_fpu() ) ) );
+                this->resume_( reinterpret_cast< intptr_t >( this) ) ) );
         this->callee_ = * hldr_from->ctx;
         if ( this->except_) rethrow_exception( this->except_);
     }
@@ -1127,10 +1072,7 @@ private:
 
         this->flags_ |= flag_unwind_stack;
         holder< void > hldr_to( & this->caller_, true);
-        this->caller_.jump(
-            this->callee_,
-            reinterpret_cast< intptr_t >( & hldr_to),
-            this->preserve_fpu() );
+        this->resume_( reinterpret_cast< intptr_t >( & hldr_to) );
         this->flags_ &= ~flag_unwind_stack;
 
         BOOST_ASSERT( this->is_complete() );
@@ -1139,11 +1081,12 @@ private:
 public:
     push_coroutine_object( const reference_wrapper< Fn > fn, attributes const& attr,
                       StackAllocator const& stack_alloc,
-                      allocator_t const& alloc) :
-        pbase_type( stack_alloc, attr.size),
+                      allocator_t const& alloc,
+                      embedded_stack * embedded) :
+        pbase_type( stack_alloc, attr, site_name< Fn >(), site_address( fn), sizeof( * this), embedded),
         base_type(
             trampoline1< push_coroutine_object >,
-            & this->stack_ctx,
+            & this->stack_ctx, this->copy, this->signal_stack,
             stack_unwind == attr.do_unwind,
             fpu_preserved == attr.preserve_fpu),
         fn_( fn),
@@ -1172,7 +1115,8 @@ public:
             BOOST_ASSERT( hldr_from->ctx);
 
             // create pull_coroutine
-            Caller c( * hldr_from->ctx, false, this->preserve_fpu(), alloc_);
+            typename Caller::caller_t impl( * hldr_from->ctx, false, this->preserve_fpu() );
+            Caller c( & impl);
             try
             { fn_( c); }
             catch ( forced_unwind const&)
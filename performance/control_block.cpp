@@ -0,0 +1,119 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// size of the control block of a coroutine (bytes requested from the
+// allocator passed to the constructor), of the context stored per side of a
+// coroutine and the costs of a switch averaged over many switches
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#ifdef BOOST_COROUTINES_UNIDIRECT
+typedef coro::coroutine< void >::pull_type  coro_t;
+
+# define COUNTER 1000000
+
+std::size_t allocated = 0;
+
+template< typename T >
+struct counting_allocator : public std::allocator< T >
+{
+    template< typename U >
+    struct rebind
+    { typedef counting_allocator< U > other; };
+
+    counting_allocator()
+    {}
+
+    template< typename U >
+    counting_allocator( counting_allocator< U > const&)
+    {}
+
+    T * allocate( std::size_t n)
+    {
+        allocated += n * sizeof( T);
+        return std::allocator< T >::allocate( n);
+    }
+};
+
+void fn( coro::coroutine< void >::push_type & c)
+{ while ( true) c(); }
+
+std::size_t control_block_size()
+{
+    allocated = 0;
+    coro_t c( fn, coro::attributes(), coro::stack_allocator(), counting_allocator< coro_t >() );
+    return allocated;
+}
+
+# if _POSIX_C_SOURCE >= 199309L
+zeit_t test_zeit( zeit_t ov, coro::flag_fpu_t preserve_fpu)
+{
+    coro_t c( fn, coro::attributes( preserve_fpu) );
+
+    // cache warum-up
+    for ( std::size_t i = 0; i < 1000; ++i)
+        c();
+
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+        c();
+    zeit_t total( zeit() - start);
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per call
+    total /= 2; // 2x jump_to c1->c2 && c2->c1
+
+    return total;
+}
+# endif
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#ifdef BOOST_COROUTINES_UNIDIRECT
+        bind_to_processor( 0);
+
+        std::cout << "context of a side of a coroutine: "
+            << sizeof( coro::detail::coroutine_context) << " bytes" << std::endl;
+        std::cout << "control block of a coroutine< void >::pull_type: "
+            << control_block_size() << " bytes" << std::endl;
+
+# if _POSIX_C_SOURCE >= 199309L
+        zeit_t ov( overhead_zeit() );
+        std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+        std::cout << "fpu preserved: average of "
+            << test_zeit( ov, coro::fpu_preserved) << " ns per switch" << std::endl;
+        std::cout << "fpu not preserved: average of "
+            << test_zeit( ov, coro::fpu_not_preserved) << " ns per switch" << std::endl;
+# endif
+#else
+        std::cout << "requires unidirectional coroutines" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// costs of creating and destroying a coroutine (resumed once) and the number
+// of allocations by its allocator - the control block allocated separately
+// and placed on top of the stack (attributes::control); the stacks are taken
+// from a pooled_stack_allocator so that mmap() does not dominate
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+typedef coro::coroutine< void >::pull_type  coro_t;
+
+# define COUNTER 100000
+
+std::size_t allocations = 0;
+
+template< typename T >
+struct counting_allocator : public std::allocator< T >
+{
+    template< typename U >
+    struct rebind
+    { typedef counting_allocator< U > other; };
+
+    counting_allocator()
+    {}
+
+    template< typename U >
+    counting_allocator( counting_allocator< U > const&)
+    {}
+
+    T * allocate( std::size_t n)
+    {
+        ++allocations;
+        return std::allocator< T >::allocate( n);
+    }
+};
+
+void fn( coro::coroutine< void >::push_type & c)
+{ c(); }
+
+zeit_t test_zeit( zeit_t ov, coro::flag_control_t control, coro::pooled_stack_allocator const& pool)
+{
+    const coro::attributes attr( 64 * 1024, control);
+    // cache warum-up, fills the pool
+    {
+        coro_t c( fn, attr, pool, counting_allocator< coro_t >() );
+    }
+
+    allocations = 0;
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+    {
+        coro_t c( fn, attr, pool, counting_allocator< coro_t >() );
+        c();
+    }
+    zeit_t total( zeit() - start);
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per coroutine
+
+    return total;
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+        bind_to_processor( 0);
+
+        zeit_t ov( overhead_zeit() );
+        std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+        coro::pooled_stack_allocator pool( 1);
+        zeit_t res = test_zeit( ov, coro::control_separate, pool);
+        std::cout << "control block allocated separately: average of " << res
+            << " ns, " << static_cast< double >( allocations) / COUNTER
+            << " allocations per coroutine" << std::endl;
+        res = test_zeit( ov, coro::control_on_stack, pool);
+        std::cout << "control block on top of the stack: average of " << res
+            << " ns, " << static_cast< double >( allocations) / COUNTER
+            << " allocations per coroutine" << std::endl;
+#else
+        std::cout << "requires unidirectional coroutines and clock_gettime()" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
@@ -153,6 +153,13 @@ int main( int argc, char * argv[])
         coro::flag_fpu_t preserve_fpu = coro::fpu_not_preserved;
         bind_to_processor( 0);
 
+        // compare with the build of performance_inline_jump
+#if defined(BOOST_COROUTINES_INLINE_JUMP)
+        std::cout << "coroutine_context::jump() inline in the headers" << std::endl;
+#else
+        std::cout << "coroutine_context::jump() called in the library" << std::endl;
+#endif
+
 #ifdef BOOST_CONTEXT_CYCLE
         {
             cycle_t ov( overhead_cycles() );
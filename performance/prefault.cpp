@@ -0,0 +1,112 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// latency of the first resume of a coroutine using some kilobytes of its
+// stack, with lazily committed stacks and with prefaulted/locked stacks
+// (attributes::prefault), from a standard and a pooled allocator
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+typedef coro::coroutine< void >::pull_type  coro_t;
+
+# define COUNTER 1000
+
+// suspends at once, touches 32kB of its stack if resumed the first time
+void fn( coro::coroutine< void >::push_type & c)
+{
+    c();
+    volatile char buffer[32 * 1024];
+    for ( std::size_t i = 0; i < sizeof( buffer); i += 64)
+        buffer[i] = 0;
+    c();
+}
+
+struct latency
+{
+    zeit_t  average;
+    zeit_t  max;
+};
+
+template< typename StackAllocator >
+latency test_zeit( zeit_t ov, coro::flag_prefault_t prefault, StackAllocator const& alloc)
+{
+    std::vector< coro_t * > coros;
+    latency result = { 0, 0 };
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+    {
+        coro_t * c = new coro_t(
+            fn, coro::attributes( 64 * 1024, prefault), alloc);
+
+        zeit_t start( zeit() );
+        ( * c)();
+        zeit_t total( zeit() - start);
+        total = total > ov ? total - ov : 0; // overhead of measurement
+
+        result.average += total;
+        if ( total > result.max) result.max = total;
+        // keep the stacks alive - a fresh stack for each coroutine
+        coros.push_back( c);
+    }
+    for ( std::size_t i = 0; i < coros.size(); ++i)
+        delete coros[i];
+    result.average /= COUNTER;
+    return result;
+}
+
+template< typename StackAllocator >
+void print( zeit_t ov, char const* name, StackAllocator const& alloc)
+{
+    static char const* modes[] = { "lazy", "prefaulted", "locked" };
+    for ( int i = coro::stack_lazy; i <= coro::stack_locked; ++i)
+    {
+        latency l = test_zeit( ov, static_cast< coro::flag_prefault_t >( i), alloc);
+        std::cout << name << ", " << modes[i] << ": average of " << l.average
+            << " ns, max " << l.max << " ns per first resume" << std::endl;
+    }
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+        bind_to_processor( 0);
+
+        zeit_t ov( overhead_zeit() );
+        std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+        print( ov, "stack_allocator", coro::stack_allocator() );
+        // fill the pool - stacks taken from the pool have been touched before
+        coro::pooled_stack_allocator pool( COUNTER);
+        test_zeit( ov, coro::stack_prefaulted, pool);
+        print( ov, "pooled_stack_allocator", pool);
+#else
+        std::cout << "requires unidirectional coroutines and clock_gettime()" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
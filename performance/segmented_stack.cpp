@@ -0,0 +1,207 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// compares coroutines running on segmented stacks (BOOST_USE_SEGMENTED_STACKS,
+// -fsplit-stack) with coroutines running on contiguous stacks:
+// - costs of a switch (a build with segmented stacks saves and restores the
+//   segment context at each switch, for contiguous stacks too)
+// - costs of growing a segmented stack
+// - memory per suspended coroutine
+// build with and without segmented stacks to compare both configurations
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+extern "C" {
+#include <unistd.h>
+}
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#ifdef BOOST_COROUTINES_UNIDIRECT
+typedef coro::coroutine< void >::pull_type  coro_t;
+typedef coro::detail::standard_stack_allocator  contiguous_allocator;
+
+# define COUNTER 1000000
+
+void fn( coro::coroutine< void >::push_type & c)
+{ while ( true) c(); }
+
+std::size_t recurse( std::size_t n)
+{
+    volatile char buffer[1024];
+    buffer[0] = 1;
+    if ( 0 == n) return 0;
+    const std::size_t depth = recurse( n - 1);
+    return depth + buffer[0];
+}
+
+// touches some kilobytes of its stack before each suspend
+void fn_deep( coro::coroutine< void >::push_type & c)
+{
+    while ( true)
+    {
+        recurse( 2);
+        c();
+    }
+}
+
+std::size_t growth_depth = 0;
+
+void fn_grow( coro::coroutine< std::size_t >::push_type & c)
+{ c( recurse( growth_depth) ); }
+
+long resident_kb()
+{
+    long size = 0, resident = 0;
+    std::FILE * f = std::fopen( "/proc/self/statm", "r");
+    if ( ! f) return -1;
+    if ( 2 != std::fscanf( f, "%ld %ld", & size, & resident) ) resident = -1;
+    std::fclose( f);
+    return -1 == resident ? -1 : resident * ( ::sysconf( _SC_PAGESIZE) / 1024);
+}
+
+# if _POSIX_C_SOURCE >= 199309L
+// `n` coroutines resumed round-robin
+template< typename StackAllocator >
+zeit_t test_zeit( zeit_t ov, std::size_t n, StackAllocator const& alloc)
+{
+    std::vector< coro_t * > coros;
+    coros.reserve( n);
+    for ( std::size_t i = 0; i < n; ++i)
+        coros.push_back( new coro_t( fn,
+            coro::attributes( StackAllocator::default_stacksize() ), alloc) );
+
+    // cache warum-up
+    for ( std::size_t i = 0; i < n; ++i)
+        ( * coros[i])();
+
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+        ( * coros[i % n])();
+    zeit_t total( zeit() - start);
+
+    for ( std::size_t i = 0; i < n; ++i)
+        delete coros[i];
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per call
+    total /= 2; // 2x jump_to c1->c2 && c2->c1
+
+    return total;
+}
+
+// coroutines recursing `depth` KB deep once: a segmented stack allocates
+// segments, a contiguous stack commits pages
+template< typename StackAllocator >
+zeit_t test_growth( zeit_t ov, std::size_t depth, StackAllocator const& alloc)
+{
+    const std::size_t n = 1000;
+    growth_depth = depth;
+    zeit_t total( 0);
+    for ( std::size_t i = 0; i < n; ++i)
+    {
+        coro::coroutine< std::size_t >::pull_type * c = 0;
+        zeit_t start( zeit() );
+        c = new coro::coroutine< std::size_t >::pull_type( fn_grow,
+            coro::attributes( StackAllocator::default_stacksize() ), alloc);
+        total += zeit() - start - ov;
+        delete c;
+    }
+    return total / n;
+}
+# endif
+
+// resident memory per suspended coroutine
+template< typename StackAllocator >
+double test_memory( std::size_t n, StackAllocator const& alloc)
+{
+    std::vector< coro_t * > coros;
+    coros.reserve( n);
+    long before = resident_kb();
+    for ( std::size_t i = 0; i < n; ++i)
+        coros.push_back( new coro_t( fn_deep,
+            coro::attributes( StackAllocator::default_stacksize() ), alloc) );
+    long after = resident_kb();
+
+    for ( std::size_t i = 0; i < n; ++i)
+        delete coros[i];
+
+    if ( -1 == before || -1 == after) return -1;
+    return static_cast< double >( after - before) * 1024 / n;
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#ifdef BOOST_COROUTINES_UNIDIRECT
+        bind_to_processor( 0);
+
+# if defined(BOOST_USE_SEGMENTED_STACKS)
+        std::cout << "built with segmented stacks" << std::endl;
+# else
+        std::cout << "built without segmented stacks" << std::endl;
+# endif
+
+# if _POSIX_C_SOURCE >= 199309L
+        {
+            zeit_t ov( overhead_zeit() );
+            std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+            std::cout << "contiguous stack, 1 coroutine: average of "
+                << test_zeit( ov, 1, contiguous_allocator() ) << " ns per switch" << std::endl;
+            std::cout << "contiguous stack, 64 coroutines: average of "
+                << test_zeit( ov, 64, contiguous_allocator() ) << " ns per switch" << std::endl;
+#  if defined(BOOST_USE_SEGMENTED_STACKS)
+            std::cout << "segmented stack, 1 coroutine: average of "
+                << test_zeit( ov, 1, coro::stack_allocator() ) << " ns per switch" << std::endl;
+            std::cout << "segmented stack, 64 coroutines: average of "
+                << test_zeit( ov, 64, coro::stack_allocator() ) << " ns per switch" << std::endl;
+#  endif
+
+            std::cout << "\ncontiguous stack, create and grow to 64KB: average of "
+                << test_growth( ov, 64, contiguous_allocator() ) << " ns" << std::endl;
+#  if defined(BOOST_USE_SEGMENTED_STACKS)
+            std::cout << "segmented stack, create and grow to 64KB: average of "
+                << test_growth( ov, 64, coro::stack_allocator() ) << " ns" << std::endl;
+#  endif
+        }
+# endif
+
+        {
+            const std::size_t n = 10000;
+            std::cout << "\ncontiguous stack: " << test_memory( n, contiguous_allocator() )
+                << " bytes per suspended coroutine" << std::endl;
+#  if defined(BOOST_USE_SEGMENTED_STACKS)
+            std::cout << "segmented stack: " << test_memory( n, coro::stack_allocator() )
+                << " bytes per suspended coroutine" << std::endl;
+#  endif
+        }
+#else
+        std::cout << "requires unidirectional coroutines" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// compares coroutines running on private stacks (standard_stack_allocator)
+// with coroutines running on shared stacks (attributes::share_stack):
+// - costs of a switch with/without copying stacks in and out
+// - memory per suspended coroutine
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+extern "C" {
+#include <unistd.h>
+}
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#ifdef BOOST_COROUTINES_UNIDIRECT
+typedef coro::coroutine< void >::pull_type  coro_t;
+
+# define COUNTER 100000
+
+// touches some kilobytes of its stack before each suspend
+void fn( coro::coroutine< void >::push_type & c)
+{
+    volatile char buffer[2048];
+    while ( true)
+    {
+        std::memset( const_cast< char * >( buffer), 0, sizeof( buffer) );
+        c();
+    }
+}
+
+long resident_kb()
+{
+    long size = 0, resident = 0;
+    std::FILE * f = std::fopen( "/proc/self/statm", "r");
+    if ( ! f) return -1;
+    if ( 2 != std::fscanf( f, "%ld %ld", & size, & resident) ) resident = -1;
+    std::fclose( f);
+    return -1 == resident ? -1 : resident * ( ::sysconf( _SC_PAGESIZE) / 1024);
+}
+
+# if _POSIX_C_SOURCE >= 199309L
+// `n` coroutines resumed round-robin
+zeit_t test_zeit( zeit_t ov, std::size_t n, coro::flag_stack_t share_stack)
+{
+    std::vector< coro_t * > coros;
+    for ( std::size_t i = 0; i < n; ++i)
+        coros.push_back(
+            new coro_t( fn, coro::attributes(
+                coro::stack_allocator::default_stacksize(), share_stack) ) );
+
+    // cache warum-up
+    for ( std::size_t i = 0; i < n; ++i)
+        ( * coros[i])();
+
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+        ( * coros[i % n])();
+    zeit_t total( zeit() - start);
+
+    for ( std::size_t i = 0; i < n; ++i)
+        delete coros[i];
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per call
+    total /= 2; // 2x jump_to c1->c2 && c2->c1
+
+    return total;
+}
+# endif
+
+// resident memory per suspended coroutine
+double test_memory( std::size_t n, coro::flag_stack_t share_stack)
+{
+    std::vector< coro_t * > coros;
+    coros.reserve( n);
+    long before = resident_kb();
+    for ( std::size_t i = 0; i < n; ++i)
+        coros.push_back(
+            new coro_t( fn, coro::attributes(
+                coro::stack_allocator::default_stacksize(), share_stack) ) );
+    // suspend all coroutines with the stack of another one in place
+    for ( std::size_t i = 0; i < n; ++i)
+        ( * coros[i])();
+    long after = resident_kb();
+
+    for ( std::size_t i = 0; i < n; ++i)
+        delete coros[i];
+
+    if ( -1 == before || -1 == after) return -1;
+    return static_cast< double >( after - before) * 1024 / n;
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#ifdef BOOST_COROUTINES_UNIDIRECT
+        bind_to_processor( 0);
+
+# if _POSIX_C_SOURCE >= 199309L
+        {
+            zeit_t ov( overhead_zeit() );
+            std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+            std::cout << "private stack, 1 coroutine: average of "
+                << test_zeit( ov, 1, coro::stack_private) << " ns per switch" << std::endl;
+            std::cout << "shared stack, 1 coroutine: average of "
+                << test_zeit( ov, 1, coro::stack_shared) << " ns per switch" << std::endl;
+            std::cout << "private stack, 64 coroutines: average of "
+                << test_zeit( ov, 64, coro::stack_private) << " ns per switch" << std::endl;
+            std::cout << "shared stack, 64 coroutines (copying): average of "
+                << test_zeit( ov, 64, coro::stack_shared) << " ns per switch" << std::endl;
+        }
+# endif
+
+        {
+            const std::size_t n = 10000;
+            std::cout << "\nprivate stack: " << test_memory( n, coro::stack_private)
+                << " bytes per suspended coroutine" << std::endl;
+            std::cout << "shared stack: " << test_memory( n, coro::stack_shared)
+                << " bytes per suspended coroutine" << std::endl;
+        }
+#else
+        std::cout << "requires unidirectional coroutines" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
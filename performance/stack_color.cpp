@@ -0,0 +1,90 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// costs of a switch if many coroutines are resumed round-robin, with
+// page-aligned stacks and with colored stacks (attributes::color_stack)
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+typedef coro::coroutine< void >::pull_type  coro_t;
+
+# define COUNTER 1000000
+
+void fn( coro::coroutine< void >::push_type & c)
+{ while ( true) c(); }
+
+// `n` coroutines resumed round-robin
+zeit_t test_zeit( zeit_t ov, std::size_t n, coro::flag_color_t color_stack)
+{
+    std::vector< coro_t * > coros;
+    coros.reserve( n);
+    for ( std::size_t i = 0; i < n; ++i)
+        coros.push_back( new coro_t( fn, coro::attributes( color_stack) ) );
+
+    // cache warum-up
+    for ( std::size_t i = 0; i < n; ++i)
+        ( * coros[i])();
+
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+        ( * coros[i % n])();
+    zeit_t total( zeit() - start);
+
+    for ( std::size_t i = 0; i < n; ++i)
+        delete coros[i];
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per call
+    total /= 2; // 2x jump_to c1->c2 && c2->c1
+
+    return total;
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+        bind_to_processor( 0);
+
+        zeit_t ov( overhead_zeit() );
+        std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+        const std::size_t counts[] = { 16, 256, 1024, 4096, 16384 };
+        for ( std::size_t i = 0; i < sizeof( counts) / sizeof( counts[0]); ++i)
+        {
+            std::cout << counts[i] << " coroutines, uncolored: average of "
+                << test_zeit( ov, counts[i], coro::stack_uncolored) << " ns per switch" << std::endl;
+            std::cout << counts[i] << " coroutines, colored: average of "
+                << test_zeit( ov, counts[i], coro::stack_colored) << " ns per switch" << std::endl;
+        }
+#else
+        std::cout << "requires unidirectional coroutines and clock_gettime()" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// costs of passing a value from a generator (coroutine< T >::push_type) to
+// the consumer (coroutine< T >::pull_type) for payloads of different size -
+// a struct of `N` bytes and a std::string of `N` characters
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/coroutine/all.hpp>
+
+#include "bind_processor.hpp"
+
+#if _POSIX_C_SOURCE >= 199309L
+#include "zeit.hpp"
+#endif
+
+namespace coro = boost::coroutines;
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+# define COUNTER 100000
+
+template< std::size_t N >
+struct payload
+{
+    char    buffer[N];
+
+    payload()
+    { std::memset( buffer, 'x', N); }
+};
+
+template< typename T >
+T make( std::size_t);
+
+template<>
+payload< 8 > make< payload< 8 > >( std::size_t)
+{ return payload< 8 >(); }
+
+template<>
+payload< 64 > make< payload< 64 > >( std::size_t)
+{ return payload< 64 >(); }
+
+template<>
+payload< 512 > make< payload< 512 > >( std::size_t)
+{ return payload< 512 >(); }
+
+template<>
+payload< 4096 > make< payload< 4096 > >( std::size_t)
+{ return payload< 4096 >(); }
+
+template<>
+std::string make< std::string >( std::size_t n)
+{ return std::string( n, 'x'); }
+
+std::size_t string_size = 0;
+
+template< typename T >
+void generate( typename coro::coroutine< T >::push_type & c)
+{
+    const T value( make< T >( string_size) );
+    while ( true) c( value);
+}
+
+template< typename T >
+zeit_t test_zeit( zeit_t ov)
+{
+    typename coro::coroutine< T >::pull_type c( generate< T >);
+
+    // cache warum-up
+    for ( std::size_t i = 0; i < 1000; ++i)
+        c();
+
+    zeit_t start( zeit() );
+    for ( std::size_t i = 0; i < COUNTER; ++i)
+        c();
+    zeit_t total( zeit() - start);
+
+    total -= ov; // overhead of measurement
+    total /= COUNTER; // per value
+
+    return total;
+}
+#endif
+
+int main( int argc, char * argv[])
+{
+    try
+    {
+#if defined(BOOST_COROUTINES_UNIDIRECT) && _POSIX_C_SOURCE >= 199309L
+        bind_to_processor( 0);
+
+        zeit_t ov( overhead_zeit() );
+        std::cout << "overhead for clock_gettime()  == " << ov << " ns" << std::endl;
+
+        std::cout << "struct of 8 bytes: average of "
+            << test_zeit< payload< 8 > >( ov) << " ns per value" << std::endl;
+        std::cout << "struct of 64 bytes: average of "
+            << test_zeit< payload< 64 > >( ov) << " ns per value" << std::endl;
+        std::cout << "struct of 512 bytes: average of "
+            << test_zeit< payload< 512 > >( ov) << " ns per value" << std::endl;
+        std::cout << "struct of 4096 bytes: average of "
+            << test_zeit< payload< 4096 > >( ov) << " ns per value" << std::endl;
+
+        const std::size_t sizes[] = { 8, 64, 512, 4096 };
+        for ( std::size_t i = 0; i < sizeof( sizes) / sizeof( sizes[0]); ++i)
+        {
+            string_size = sizes[i];
+            std::cout << "std::string of " << sizes[i] << " characters: average of "
+                << test_zeit< std::string >( ov) << " ns per value" << std::endl;
+        }
+#else
+        std::cout << "requires unidirectional coroutines and clock_gettime()" << std::endl;
+#endif
+
+        return EXIT_SUCCESS;
+    }
+    catch ( std::exception const& e)
+    { std::cerr << "exception: " << e.what() << std::endl; }
+    catch (...)
+    { std::cerr << "unhandled exception" << std::endl; }
+    return EXIT_FAILURE;
+}
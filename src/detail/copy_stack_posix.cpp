@@ -0,0 +1,308 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/copy_stack.hpp"
+
+extern "C" {
+#include <pthread.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/context/fcontext.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/coroutine/detail/coroutine_context.hpp>
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+struct shared_stack
+{
+    stack_context       sctx;
+    std::size_t         size;       // requested size
+    copy_stack      *   occupant;   // coroutine whose stack is in place
+    std::size_t         users;      // coroutines assigned to this stack
+    bool                orphaned;   // owning thread has terminated
+};
+
+namespace {
+
+struct environment;
+
+// passed from coroutine_context::jump() to the swapper
+struct swap_request
+{
+    environment         *   env;
+    copy_stack          *   to;         // coroutine to place on its stack
+    context::fcontext_t *   fctx;       // jumped to if `to` is in place
+    context::fcontext_t *   back;       // requesting side
+    intptr_t                param;
+    bool                    preserve_fpu;
+    bool                    failed;     // `to` could not be placed
+};
+
+// per thread: shared stacks and the context copying stacks in and out
+// (runs on a private stack because the shared stack gets overwritten)
+struct environment
+{
+    copy_stack                  *   current;    // coroutine running on a shared stack
+    context::fcontext_t         *   swapper;
+    stack_context                   swapper_stack;
+    std::vector< shared_stack * >   stacks;
+    std::size_t                     next;
+};
+
+pthread_key_t   env_key;
+pthread_once_t  env_once = PTHREAD_ONCE_INIT;
+
+// shared stacks of terminated threads are released by the last coroutine
+// using them, possibly on another thread
+pthread_mutex_t orphan_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+void release_shared_stack( shared_stack * stack)
+{
+    standard_stack_allocator().deallocate( stack->sctx);
+    delete stack;
+}
+
+void destroy_environment( void * vp)
+{
+    environment * env = static_cast< environment * >( vp);
+    {
+        mutex_guard lk( & orphan_mtx);
+        for ( std::size_t i = 0; i < env->stacks.size(); ++i)
+        {
+            // coroutines still assigned to a stack release it
+            if ( 0 == env->stacks[i]->users) release_shared_stack( env->stacks[i]);
+            else env->stacks[i]->orphaned = true;
+        }
+    }
+    standard_stack_allocator().deallocate( env->swapper_stack);
+    delete env;
+}
+
+void create_env_key()
+{
+#if defined(BOOST_DISABLE_ASSERTS)
+    ::pthread_key_create( & env_key, destroy_environment);
+#else
+    const int result = ::pthread_key_create( & env_key, destroy_environment);
+    BOOST_ASSERT( 0 == result);
+#endif
+}
+
+bool owned_by_this_thread( copy_stack const& rec)
+{ return rec.owner == ::pthread_getspecific( env_key); }
+
+// false if the buffer can not hold the used part of the stack - nothing is
+// changed then
+bool save( copy_stack & rec)
+{
+    BOOST_ASSERT( rec.stack);
+    BOOST_ASSERT( rec.ctx && rec.ctx->registers() );
+
+    char * top = static_cast< char * >( rec.stack->sctx.sp);
+    // the stack above the saved stack pointer is in use - the whole stack
+    // except the guard page if the stack pointer is unknown
+    char * sp = saved_stack_pointer( * rec.ctx->registers() );
+    if ( ! sp) sp = top - rec.stack->sctx.size + pagesize();
+    const std::size_t used( top - sp);
+    // keep the buffer right-sized
+    if ( used > rec.capacity || used < rec.capacity / 2)
+    {
+        char * buffer = static_cast< char * >( std::realloc( rec.buffer, used) );
+        if ( buffer)
+        {
+            rec.buffer = buffer;
+            rec.capacity = used;
+        }
+        else if ( used > rec.capacity) return false;
+    }
+    std::memcpy( rec.buffer, sp, used);
+    rec.used = used;
+    return true;
+}
+
+void restore( copy_stack const& rec)
+{ std::memcpy( static_cast< char * >( rec.stack->sctx.sp) - rec.used, rec.buffer, rec.used); }
+
+// prefers a stack not in use
+shared_stack * assign_shared_stack( environment * env, std::size_t size)
+{
+    shared_stack * stack = 0;
+    const std::size_t count( env->stacks.size() );
+    for ( std::size_t i = 0; i < count; ++i)
+    {
+        shared_stack * candidate = env->stacks[( env->next + i) % count];
+        if ( size != candidate->size) continue;
+        if ( ! candidate->occupant) return candidate;
+        if ( ! stack) stack = candidate;
+    }
+    ++env->next;
+    BOOST_ASSERT_MSG( stack, "no shared stack available");
+    return stack;
+}
+
+void swap_stacks( intptr_t vp)
+{
+    for (;;)
+    {
+        // the requesting side reads `failed` after being resumed
+        swap_request * from = reinterpret_cast< swap_request * >( vp);
+        swap_request req( * from);
+
+        const bool start( ! req.to->stack);
+        shared_stack * stack = start
+            ? assign_shared_stack( req.env, req.to->size)
+            : req.to->stack;
+        if ( stack->occupant && ! save( * stack->occupant) )
+        {
+            // nothing was overwritten - the requesting side reports the failure
+            from->failed = true;
+            vp = context::jump_fcontext( req.env->swapper, req.back, 0, req.preserve_fpu);
+            continue;
+        }
+        stack->occupant = req.to;
+
+        if ( start)
+        {
+            req.to->stack = stack;
+            ++stack->users;
+            req.fctx = context::make_fcontext( stack->sctx.sp, stack->sctx.size, req.to->fn);
+        }
+        else
+            restore( * req.to);
+
+        vp = context::jump_fcontext( req.env->swapper, req.fctx, req.param, req.preserve_fpu);
+    }
+}
+
+environment * local_environment()
+{
+    ::pthread_once( & env_once, create_env_key);
+    environment * env = static_cast< environment * >( ::pthread_getspecific( env_key) );
+    if ( ! env)
+    {
+        env = new environment();
+        standard_stack_allocator alloc;
+        try
+        { alloc.allocate( env->swapper_stack, standard_stack_allocator::default_stacksize() ); }
+        catch (...)
+        {
+            delete env;
+            throw;
+        }
+        env->swapper = context::make_fcontext(
+            env->swapper_stack.sp, env->swapper_stack.size, swap_stacks);
+        ::pthread_setspecific( env_key, env);
+    }
+    return env;
+}
+
+}
+
+copy_stack * create_copy_stack( std::size_t size)
+{
+    environment * env = local_environment();
+
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < env->stacks.size(); ++i)
+        if ( size == env->stacks[i]->size) ++count;
+    // shared stacks are added while coroutines are created; at least two
+    // are required so that a coroutine can resume another one
+    if ( count < ( std::max)( std::size_t( 2), std::size_t( BOOST_COROUTINES_SHARED_STACKS) ) )
+    {
+        env->stacks.reserve( env->stacks.size() + 1);
+        shared_stack * stack = new shared_stack();
+        try
+        { standard_stack_allocator().allocate( stack->sctx, size); }
+        catch (...)
+        {
+            delete stack;
+            throw;
+        }
+        stack->size = size;
+        env->stacks.push_back( stack);
+    }
+
+    copy_stack * rec = new copy_stack();
+    rec->size = size;
+    rec->owner = env;
+    return rec;
+}
+
+void destroy_copy_stack( copy_stack * rec)
+{
+    BOOST_ASSERT( rec);
+
+    shared_stack * stack = rec->stack;
+    if ( stack)
+    {
+        mutex_guard lk( & orphan_mtx);
+        BOOST_ASSERT_MSG( stack->orphaned || owned_by_this_thread( * rec),
+                          "coroutine with a shared stack destroyed by another thread");
+        if ( rec == stack->occupant) stack->occupant = 0;
+        --stack->users;
+        if ( stack->orphaned && 0 == stack->users) release_shared_stack( stack);
+    }
+    std::free( rec->buffer);
+    delete rec;
+}
+
+intptr_t
+coroutine_context::jump_copy_stack( coroutine_context & other, copy_stack * to,
+                                    intptr_t param, bool preserve_fpu)
+{
+    BOOST_ASSERT_MSG( owned_by_this_thread( * to),
+                      "coroutine with a shared stack resumed by another thread");
+    environment * env = static_cast< environment * >( to->owner);
+    // data passed by the resuming coroutine lives on its stack which might be
+    // the stack of the resumed one
+    BOOST_ASSERT_MSG( ! env->current,
+                      "coroutine with a shared stack resumed while a coroutine with a "
+                      "shared stack is running");
+
+    // registers of this context while suspended, the frame lives until the
+    // coroutine suspends again
+    context::fcontext_t fctx;
+    ctx_ = & fctx;
+
+    env->current = to;
+    if ( to->stack && to == to->stack->occupant)
+    {
+        const intptr_t result = context::jump_fcontext( ctx_, other.ctx_, param, preserve_fpu);
+        env->current = 0;
+        return result;
+    }
+
+    swap_request req = { env, to, other.ctx_, ctx_, param, preserve_fpu, false };
+    const intptr_t result = context::jump_fcontext(
+        ctx_, env->swapper, reinterpret_cast< intptr_t >( & req), preserve_fpu);
+    env->current = 0;
+    if ( req.failed) boost::throw_exception( std::bad_alloc() );
+    return result;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -6,10 +6,9 @@
 
 #include "boost/coroutine/detail/coroutine_context.hpp"
 
-#ifdef BOOST_MSVC
- #pragma warning (push)
- #pragma warning (disable: 4355) // using 'this' in initializer list
-#endif
+#include "boost/coroutine/detail/copy_stack.hpp"
+#include "boost/coroutine/detail/stack_image.hpp"
+#include "boost/coroutine/detail/stack_utils.hpp"
 
 #if defined(BOOST_USE_SEGMENTED_STACKS)
 extern "C" {
@@ -34,61 +33,74 @@ namespace coroutines {
 namespace detail {
 
 coroutine_context::coroutine_context() :
-    fcontext_t(), stack_ctx_( this), ctx_( this)
-{
+    ctx_( 0)
 #if defined(BOOST_USE_SEGMENTED_STACKS)
-    __splitstack_getcontext( stack_ctx_->segments_ctx);
+    , segments_( 0)
 #endif
-}
-
-coroutine_context::coroutine_context( ctx_fn fn, stack_context * stack_ctx) :
-    fcontext_t(), stack_ctx_( stack_ctx),
-    ctx_( context::make_fcontext( stack_ctx_->sp, stack_ctx_->size, fn) )
-{}
-
-coroutine_context::coroutine_context( coroutine_context const& other) :
-    fcontext_t(),
-    stack_ctx_( other.stack_ctx_),
-    ctx_( other.ctx_)
 {}
 
-coroutine_context &
-coroutine_context::operator=( coroutine_context const& other)
+coroutine_context::coroutine_context( ctx_fn fn, stack_context * stack_ctx, copy_stack * copy) :
+    ctx_( 0)
+#if defined(BOOST_USE_SEGMENTED_STACKS)
+    , segments_( stack_ctx->segments_ctx)
+#endif
 {
-    if ( this == & other) return * this;
-
-    stack_ctx_ = other.stack_ctx_;
-    ctx_ = other.ctx_;
-
-    return * this;
+    // a shared stack gets assigned at the first resumption; the registers of
+    // the coroutine are read from this context (assigned after each switch)
+    if ( copy)
+    {
+        copy->fn = fn;
+        copy->ctx = this;
+    }
+    else ctx_ = context::make_fcontext( stack_ctx->sp, stack_ctx->size, fn);
 }
 
+#if defined(BOOST_USE_SEGMENTED_STACKS)
 intptr_t
 coroutine_context::jump( coroutine_context & other, intptr_t param, bool preserve_fpu)
 {
-#if defined(BOOST_USE_SEGMENTED_STACKS)
-    BOOST_ASSERT( stack_ctx_);
-    BOOST_ASSERT( other.stack_ctx_);
+    // registers of this context while suspended, the frame of jump() lives
+    // until the context is resumed
+    context::fcontext_t fctx;
+    ctx_ = & fctx;
+
+    BOOST_ASSERT( other.segments_);
 
-    __splitstack_getcontext( stack_ctx_->segments_ctx);
-    __splitstack_setcontext( other.stack_ctx_->segments_ctx);
+    stack_context::segments_context segments;
+    __splitstack_getcontext( segments);
+    segments_ = segments;
+    __splitstack_setcontext( other.segments_);
     intptr_t ret = context::jump_fcontext( ctx_, other.ctx_, param, preserve_fpu);
 
-    BOOST_ASSERT( stack_ctx_);
-    __splitstack_setcontext( stack_ctx_->segments_ctx);
+    __splitstack_setcontext( segments);
 
     return ret;
+}
+#endif
+
+stack_image *
+coroutine_context::hibernate( stack_context * stack_ctx) const
+{
+    // no stack of its own (a shared stack is not allocated) or never suspended
+    if ( ! stack_ctx || ! stack_ctx->sp || ! ctx_) return 0;
+#if defined(BOOST_USE_SEGMENTED_STACKS)
+    return 0;
 #else
-    return context::jump_fcontext( ctx_, other.ctx_, param, preserve_fpu);
+    // the stack above the saved stack pointer is in use
+    char * sp = saved_stack_pointer( * ctx_);
+    if ( ! sp) return 0;
+    return hibernate_stack( * stack_ctx, sp);
 #endif
 }
 
 }}}
 
-#ifdef BOOST_HAS_ABI_HEADERS
-#  include BOOST_ABI_SUFFIX
+#if ! defined(BOOST_USE_SEGMENTED_STACKS) && ! defined(BOOST_COROUTINES_INLINE_JUMP)
+# define BOOST_COROUTINES_JUMP_INLINE
+# include "boost/coroutine/detail/coroutine_context_jump.ipp"
+# undef BOOST_COROUTINES_JUMP_INLINE
 #endif
 
-#ifdef BOOST_MSVC
- #pragma warning (pop)
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
 #endif
@@ -0,0 +1,229 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/deferred_stack_allocator.hpp"
+
+extern "C" {
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/slab_stack_allocator.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// a queued stack is linked into the list by a pointer and its size
+// stored at the top of its (unused) memory
+inline
+void * & next_of( void * sp)
+{ return * ( static_cast< void ** >( sp) - 1); }
+
+inline
+std::size_t & size_of( void * sp)
+{ return * ( static_cast< std::size_t * >( sp) - 2); }
+
+void * volatile         queued = 0;
+volatile std::size_t    queued_count = 0;
+
+void enqueue( stack_context const& ctx)
+{
+    void * sp = ctx.sp;
+    size_of( sp) = ctx.size;
+    void * old;
+    do
+    {
+        old = queued;
+        next_of( sp) = old;
+    }
+    while ( ! __sync_bool_compare_and_swap( & queued, old, sp) );
+    __sync_add_and_fetch( & queued_count, 1);
+}
+
+// one reclaim() at a time, deallocate() does not wait for it
+pthread_mutex_t reclaim_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+std::size_t reclaim_( bool wait)
+{
+    if ( wait) ::pthread_mutex_lock( & reclaim_mtx);
+    else if ( 0 != ::pthread_mutex_trylock( & reclaim_mtx) ) return 0;
+
+    // the list is taken as a whole - no ABA problem
+    void * sp = __sync_lock_test_and_set( & queued, static_cast< void * >( 0) );
+    std::vector< slab_slot > slots;
+    for ( ; sp; sp = next_of( sp) )
+        slots.push_back( slab_slot( static_cast< char * >( sp) - size_of( sp), size_of( sp) ) );
+    __sync_sub_and_fetch( & queued_count, slots.size() );
+
+    // release contiguous slots at once
+    std::sort( slots.begin(), slots.end() );
+    if ( ! slots.empty() ) release_slab_slots( & slots[0], slots.size() );
+
+    ::pthread_mutex_unlock( & reclaim_mtx);
+    return slots.size();
+}
+
+pthread_mutex_t reaper_mtx = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  reaper_cond = PTHREAD_COND_INITIALIZER;
+// signalled after each pass of the reaper and if it stops
+pthread_cond_t  reaper_pass_cond = PTHREAD_COND_INITIALIZER;
+pthread_t       reaper;
+bool            reaper_running = false;
+bool            reaper_stop = false;
+bool            reaper_flush = false;
+std::size_t     reaper_interval_ms = 0;
+std::size_t     reaper_started = 0;     // passes started
+std::size_t     reaper_done = 0;        // passes completed
+
+void * reap( void *)
+{
+    mutex_guard lk( & reaper_mtx);
+    while ( ! reaper_stop)
+    {
+        timeval now;
+        ::gettimeofday( & now, 0);
+        const long nsec( now.tv_usec * 1000L + static_cast< long >( reaper_interval_ms % 1000) * 1000000L);
+        timespec until;
+        until.tv_sec = now.tv_sec + reaper_interval_ms / 1000 + nsec / 1000000000L;
+        until.tv_nsec = nsec % 1000000000L;
+        if ( ETIMEDOUT == ::pthread_cond_timedwait( & reaper_cond, & reaper_mtx, & until) || reaper_flush)
+        {
+            if ( reaper_stop) break;
+            reaper_flush = false;
+            ++reaper_started;
+            ::pthread_mutex_unlock( & reaper_mtx);
+            reclaim_( true);
+            ::pthread_mutex_lock( & reaper_mtx);
+            ++reaper_done;
+            ::pthread_cond_broadcast( & reaper_pass_cond);
+        }
+    }
+    ::pthread_cond_broadcast( & reaper_pass_cond);
+    return 0;
+}
+
+}
+
+bool
+deferred_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+deferred_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+deferred_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+deferred_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+std::size_t
+deferred_stack_allocator::pending()
+{ return queued_count; }
+
+std::size_t
+deferred_stack_allocator::reclaim()
+{ return reclaim_( true); }
+
+void
+deferred_stack_allocator::start_reaper( std::size_t interval_ms)
+{
+    BOOST_ASSERT( 0 < interval_ms);
+
+    mutex_guard lk( & reaper_mtx);
+    reaper_interval_ms = interval_ms;
+    if ( reaper_running) return;
+    reaper_stop = false;
+    if ( 0 != ::pthread_create( & reaper, 0, reap, 0) ) throw std::bad_alloc();
+    reaper_running = true;
+}
+
+void
+deferred_stack_allocator::flush_reaper()
+{
+    {
+        mutex_guard lk( & reaper_mtx);
+        if ( reaper_running)
+        {
+            // a pass started after this call releases the stacks queued before
+            const std::size_t pass( reaper_started + 1);
+            reaper_flush = true;
+            ::pthread_cond_signal( & reaper_cond);
+            while ( reaper_done < pass && ! reaper_stop)
+                ::pthread_cond_wait( & reaper_pass_cond, & reaper_mtx);
+            if ( ! reaper_stop) return;
+        }
+    }
+    // no reaper thread
+    reclaim_( true);
+}
+
+void
+deferred_stack_allocator::stop_reaper()
+{
+    {
+        mutex_guard lk( & reaper_mtx);
+        if ( ! reaper_running) return;
+        reaper_stop = true;
+        ::pthread_cond_signal( & reaper_cond);
+    }
+    ::pthread_join( reaper, 0);
+    {
+        mutex_guard lk( & reaper_mtx);
+        reaper_running = false;
+    }
+    reclaim_( true);
+}
+
+deferred_stack_allocator::deferred_stack_allocator( std::size_t batch, std::size_t stacks_per_slab) :
+    batch_( batch),
+    slab_( stacks_per_slab, guard_per_stack)
+{}
+
+void
+deferred_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{ slab_.allocate( ctx, size); }
+
+void
+deferred_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+    BOOST_ASSERT( minimum_stacksize() <= ctx.size);
+
+    record_stack_deallocated();
+    enqueue( ctx);
+    // another thread releasing stacks takes the new one too
+    if ( 0 < batch_ && batch_ <= queued_count) reclaim_( false);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
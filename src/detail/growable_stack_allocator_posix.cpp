@@ -0,0 +1,222 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/growable_stack_allocator.hpp"
+
+extern "C" {
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <new>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/overflow_diagnostics.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// address range of a stack, read by the signal handler without locking;
+// records are never freed but reused for new stacks
+struct growable_region
+{
+    char * volatile         limit;      // lowest address above the guard page
+    char * volatile         committed;  // lowest accessible address
+    char * volatile         top;        // 0 if not in use
+    growable_region     *   next;
+};
+
+growable_region * volatile  regions = 0;
+
+pthread_mutex_t regions_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+// regions of the allocated stacks, by stack pointer
+std::map< void *, growable_region * > & stacks()
+{
+    static std::map< void *, growable_region * > * m =
+        new std::map< void *, growable_region * >();
+    return * m;
+}
+
+struct sigaction    previous_action;
+
+char * page_down( char * p)
+{ return reinterpret_cast< char * >( reinterpret_cast< std::size_t >( p) / pagesize() * pagesize() ); }
+
+void grow_on_fault( int sig, siginfo_t * info, void * uctx)
+{
+    char * addr = static_cast< char * >( info->si_addr);
+    for ( growable_region * r = regions; r; r = r->next)
+    {
+        char * top = r->top;
+        if ( ! top) continue;
+        char * committed = r->committed;
+        char * limit = r->limit;
+        if ( addr < limit || committed <= addr) continue;
+
+        // at least double the accessible part of the stack
+        const std::size_t used( top - committed);
+        char * lower = page_down( addr);
+        if ( static_cast< std::size_t >( committed - limit) > used)
+            lower = ( std::min)( lower, committed - used);
+        lower = ( std::max)( lower, limit);
+        if ( 0 != ::mprotect( lower, committed - lower, PROT_READ | PROT_WRITE) )
+            break;
+        r->committed = lower;
+        return;
+    }
+    chain_signal( previous_action, sig, info, uctx);
+}
+
+// the handler is installed again if a different one was installed meanwhile
+void install_handler()
+{
+    struct sigaction current;
+    ::sigaction( SIGSEGV, 0, & current);
+    if ( ( current.sa_flags & SA_SIGINFO) && grow_on_fault == current.sa_sigaction)
+        return;
+
+    struct sigaction action;
+    action.sa_sigaction = grow_on_fault;
+    ::sigemptyset( & action.sa_mask);
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    ::sigaction( SIGSEGV, & action, & previous_action);
+}
+
+}
+
+bool
+growable_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+growable_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+growable_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+growable_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+void
+growable_stack_allocator::prepare_thread()
+{ prepare_signal_stack(); }
+
+std::size_t
+growable_stack_allocator::committed( stack_context const& ctx)
+{
+    mutex_guard lk( & regions_mtx);
+    std::map< void *, growable_region * >::const_iterator i( detail::stacks().find( ctx.sp) );
+    BOOST_ASSERT( detail::stacks().end() != i);
+    return i->second->top - i->second->committed;
+}
+
+growable_stack_allocator::growable_stack_allocator( std::size_t reserve) :
+    reserve_( reserve)
+{}
+
+void
+growable_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    prepare_thread();
+
+    // memory layout:
+    // [guard page|reserved (PROT_NONE)|committed (size bytes)]
+    const std::size_t committed_( page_count( size) * pagesize() );
+    const std::size_t reserved( ( std::max)( page_count( reserve_) * pagesize(), committed_) );
+    const std::size_t size_( reserved + pagesize() );
+    char * limit = static_cast< char * >(
+        ::mmap( 0, size_, PROT_NONE, stack_map_flags(), -1, 0) );
+    if ( MAP_FAILED == static_cast< void * >( limit) ) throw std::bad_alloc();
+
+    char * top = limit + size_;
+    if ( 0 != ::mprotect( top - committed_, committed_, PROT_READ | PROT_WRITE) )
+    {
+        ::munmap( limit, size_);
+        throw std::bad_alloc();
+    }
+
+    ctx.size = size_;
+    ctx.sp = top;
+
+    mutex_guard lk( & regions_mtx);
+    install_handler();
+
+    growable_region * r = 0;
+    for ( growable_region * i = regions; i; i = i->next)
+        if ( ! i->top) { r = i; break; }
+    const bool fresh( ! r);
+    if ( fresh)
+    {
+        r = new ( std::nothrow) growable_region();
+        if ( ! r)
+        {
+            ::munmap( limit, size_);
+            throw std::bad_alloc();
+        }
+        r->next = regions;
+    }
+    r->limit = limit + pagesize();
+    r->committed = top - committed_;
+    __sync_synchronize();
+    r->top = top;
+    if ( fresh)
+    {
+        __sync_synchronize();
+        regions = r;
+    }
+    detail::stacks()[ctx.sp] = r;
+    name_stack_mapping( limit, size_, 0);
+    record_stack_mapped( limit, size_);
+    record_stack_allocated();
+}
+
+void
+growable_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    {
+        mutex_guard lk( & regions_mtx);
+        std::map< void *, growable_region * >::iterator i( detail::stacks().find( ctx.sp) );
+        BOOST_ASSERT( detail::stacks().end() != i);
+        i->second->top = 0;
+        __sync_synchronize();
+        detail::stacks().erase( i);
+    }
+
+    void * limit = static_cast< char * >( ctx.sp) - ctx.size;
+    record_stack_deallocated();
+    record_stack_unmapped( limit, ctx.size);
+    ::munmap( limit, ctx.size);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -0,0 +1,200 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/hugepage_stack_allocator.hpp"
+
+extern "C" {
+#include <sys/mman.h>
+}
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <new>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+std::size_t hugepagesize_()
+{
+    std::size_t size = 2 * 1024 * 1024;
+#if defined(__linux__)
+    std::FILE * f = std::fopen("/proc/meminfo", "r");
+    if ( ! f) return size;
+    char line[128];
+    while ( std::fgets( line, sizeof( line), f) )
+    {
+        unsigned long kb = 0;
+        if ( 1 == std::sscanf( line, "Hugepagesize: %lu kB", & kb) && 0 < kb)
+        {
+            size = static_cast< std::size_t >( kb) * 1024;
+            break;
+        }
+    }
+    std::fclose( f);
+#endif
+    return size;
+}
+
+std::size_t round_up( std::size_t n, std::size_t align)
+{ return ( n + align - 1) / align * align; }
+
+pthread_mutex_t stacks_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+// backing of the allocated stacks, by stack pointer
+std::map< void *, hugepage_stack_allocator::backing_t > & stacks()
+{
+    static std::map< void *, hugepage_stack_allocator::backing_t > * m =
+        new std::map< void *, hugepage_stack_allocator::backing_t >();
+    return * m;
+}
+
+}
+
+bool
+hugepage_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+hugepage_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+hugepage_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+hugepage_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+std::size_t
+hugepage_stack_allocator::hugepagesize()
+{
+    static std::size_t size = hugepagesize_();
+    return size;
+}
+
+hugepage_stack_allocator::backing_t
+hugepage_stack_allocator::backing( stack_context const& ctx)
+{
+    mutex_guard lk( & stacks_mtx);
+    std::map< void *, backing_t >::const_iterator i( detail::stacks().find( ctx.sp) );
+    BOOST_ASSERT( detail::stacks().end() != i);
+    return i->second;
+}
+
+std::size_t
+hugepage_stack_allocator::stacks( backing_t b)
+{
+    mutex_guard lk( & stacks_mtx);
+    std::size_t n = 0;
+    for ( std::map< void *, backing_t >::const_iterator i( detail::stacks().begin() );
+          i != detail::stacks().end(); ++i)
+        if ( b == i->second) ++n;
+    return n;
+}
+
+hugepage_stack_allocator::hugepage_stack_allocator( bool use_hugetlb) :
+    use_hugetlb_( use_hugetlb)
+{}
+
+void
+hugepage_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    // memory layout:
+    // [slack|guard page|stack (aligned to hugepagesize())|slack]
+    // the address range is reserved first, the slack is unmapped afterwards
+    const std::size_t size_( round_up( size, hugepagesize() ) );
+    const std::size_t reserved( size_ + hugepagesize() + pagesize() );
+    char * region = static_cast< char * >(
+        ::mmap( 0, reserved, PROT_NONE, stack_map_flags(), -1, 0) );
+    if ( MAP_FAILED == static_cast< void * >( region) ) throw std::bad_alloc();
+
+    char * stack = reinterpret_cast< char * >(
+        round_up( reinterpret_cast< std::size_t >( region) + pagesize(), hugepagesize() ) );
+    char * guard = stack - pagesize();
+    BOOST_ASSERT( region <= guard);
+    BOOST_ASSERT( stack + size_ <= region + reserved);
+
+    backing_t b = normal_pages;
+    void * vp = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+    // fails if no huge pages are configured/available
+    if ( use_hugetlb_)
+    {
+        vp = ::mmap( stack, size_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0);
+        if ( MAP_FAILED != vp) b = huge_pages;
+    }
+#endif
+    if ( MAP_FAILED == vp)
+    {
+        vp = ::mmap( stack, size_, PROT_READ | PROT_WRITE,
+                     stack_map_flags() | MAP_FIXED, -1, 0);
+        if ( MAP_FAILED == vp)
+        {
+            ::munmap( region, reserved);
+            throw std::bad_alloc();
+        }
+#if defined(MADV_HUGEPAGE)
+        // fails if transparent huge pages are disabled
+        if ( 0 == ::madvise( stack, size_, MADV_HUGEPAGE) ) b = transparent_huge_pages;
+#endif
+    }
+    BOOST_ASSERT( stack == vp);
+
+    // release the slack, the guard page remains PROT_NONE
+    if ( region < guard) ::munmap( region, guard - region);
+    if ( stack + size_ < region + reserved)
+        ::munmap( stack + size_, region + reserved - ( stack + size_) );
+
+    ctx.size = size_ + pagesize();
+    ctx.sp = stack + size_;
+    name_stack_mapping( guard, ctx.size, 0);
+    record_stack_mapped( guard, ctx.size);
+    record_stack_allocated();
+
+    mutex_guard lk( & stacks_mtx);
+    detail::stacks()[ctx.sp] = b;
+}
+
+void
+hugepage_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    {
+        mutex_guard lk( & stacks_mtx);
+        detail::stacks().erase( ctx.sp);
+    }
+
+    void * limit = static_cast< char * >( ctx.sp) - ctx.size;
+    record_stack_deallocated();
+    record_stack_unmapped( limit, ctx.size);
+    ::munmap( limit, ctx.size);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
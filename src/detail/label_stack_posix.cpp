@@ -0,0 +1,82 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/label_stack.hpp"
+
+#if defined(__linux__)
+extern "C" {
+#include <sys/prctl.h>
+}
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+// Linux 5.17, <linux/prctl.h>
+#if defined(__linux__)
+# if ! defined(PR_SET_VMA)
+#  define PR_SET_VMA 0x53564d41
+# endif
+# if ! defined(PR_SET_VMA_ANON_NAME)
+#  define PR_SET_VMA_ANON_NAME 0
+# endif
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+#if defined(__linux__)
+namespace {
+
+// set once the kernel rejected naming a mapping (Linux < 5.17 or
+// CONFIG_ANON_VMA_NAME not set) - no further prctl() is issued
+volatile bool unsupported = false;
+
+}
+#endif
+
+void name_stack_mapping( void * base, std::size_t size, char const* label) BOOST_NOEXCEPT
+{
+#if defined(__linux__)
+    if ( __atomic_load_n( & unsupported, __ATOMIC_RELAXED) ) return;
+    // the kernel limits names to 80 bytes of printable characters except [, ], \, $ and `
+    char name[80];
+    std::size_t n = std::strlen( BOOST_COROUTINES_STACK_NAME);
+    std::memcpy( name, BOOST_COROUTINES_STACK_NAME, n);
+    if ( label)
+    {
+        name[n++] = ':';
+        for ( ; * label && n < sizeof( name) - 1; ++label)
+        {
+            const char c = * label;
+            name[n++] = ( ' ' > c || '~' < c || std::strchr( "[]\\$`", c) ) ? '_' : c;
+        }
+    }
+    name[n] = '\0';
+    // the kernel copies the name
+    if ( 0 != ::prctl( PR_SET_VMA, PR_SET_VMA_ANON_NAME, base, size, name) && EINVAL == errno)
+        __atomic_store_n( & unsupported, true, __ATOMIC_RELAXED);
+#else
+    ( void) base; ( void) size; ( void) label;
+#endif
+}
+
+void label_stack( stack_context const& ctx, char const* label) BOOST_NOEXCEPT
+{ name_stack_mapping( static_cast< char * >( ctx.sp) - ctx.size, ctx.size, label); }
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
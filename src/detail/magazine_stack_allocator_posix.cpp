@@ -0,0 +1,343 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/magazine_stack_allocator.hpp"
+
+extern "C" {
+#include <pthread.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+const std::size_t magazine_size = BOOST_COROUTINES_MAGAZINE_SIZE;
+
+struct magazine
+{
+    volatile uint32_t   next;       // next magazine in a depot list
+    std::size_t         count;
+    void            *   stacks[magazine_size];
+};
+
+// magazines are never freed; they are referred to by index + 1 (0 == none)
+// so that a depot list can tag its head against ABA
+const uint32_t chunk_magazines = 256;
+const uint32_t max_chunks = 4096;
+
+magazine * volatile chunks[max_chunks];
+volatile uint32_t   magazines_created = 0;
+
+magazine & magazine_at( uint32_t ref)
+{
+    BOOST_ASSERT( 0 < ref);
+    return chunks[( ref - 1) / chunk_magazines][( ref - 1) % chunk_magazines];
+}
+
+// returns 0 if no magazine can be created
+uint32_t create_magazine()
+{
+    const uint32_t idx = __sync_fetch_and_add( & magazines_created, 1);
+    if ( chunk_magazines * max_chunks <= idx) return 0;
+
+    const uint32_t c = idx / chunk_magazines;
+    if ( ! chunks[c])
+    {
+        magazine * chunk = new ( std::nothrow) magazine[chunk_magazines];
+        if ( ! chunk) return 0;
+        if ( ! __sync_bool_compare_and_swap( & chunks[c], static_cast< magazine * >( 0), chunk) )
+            delete [] chunk;
+    }
+    magazine & m = magazine_at( idx + 1);
+    m.next = 0;
+    m.count = 0;
+    return idx + 1;
+}
+
+// lock-free list of magazines, the head holds a tag in its upper half
+struct depot_list
+{
+    volatile uint64_t   head;
+};
+
+void push( depot_list & l, uint32_t ref)
+{
+    magazine & m = magazine_at( ref);
+    uint64_t old, head;
+    do
+    {
+        old = l.head;
+        m.next = static_cast< uint32_t >( old);
+        head = ( ( ( old >> 32) + 1) << 32) | ref;
+    }
+    while ( ! __sync_bool_compare_and_swap( & l.head, old, head) );
+}
+
+uint32_t pop( depot_list & l)
+{
+    uint64_t old, head;
+    do
+    {
+        old = l.head;
+        const uint32_t ref = static_cast< uint32_t >( old);
+        if ( 0 == ref) return 0;
+        // a magazine popped meanwhile changes the tag, the CAS fails
+        head = ( ( ( old >> 32) + 1) << 32) | magazine_at( ref).next;
+    }
+    while ( ! __sync_bool_compare_and_swap( & l.head, old, head) );
+    return static_cast< uint32_t >( old);
+}
+
+// magazines holding stacks (not necessarily full), one list per size class
+depot_list          full_magazines[size_classes];
+depot_list          empty_magazines;
+volatile std::size_t cached_stacks = 0;
+
+struct thread_cache
+{
+    uint32_t    loaded[size_classes];
+    uint32_t    previous[size_classes];
+
+    thread_cache()
+    {
+        for ( std::size_t k = 0; k < size_classes; ++k)
+        {
+            loaded[k] = 0;
+            previous[k] = 0;
+        }
+    }
+};
+
+stack_context stack_of( std::size_t k, void * sp)
+{
+    stack_context ctx;
+    ctx.sp = sp;
+    ctx.size = ( ( std::size_t( 1) << k) + 1) * pagesize();
+    return ctx;
+}
+
+void return_magazine( std::size_t k, uint32_t ref)
+{
+    if ( 0 == ref) return;
+    if ( 0 < magazine_at( ref).count) push( full_magazines[k], ref);
+    else push( empty_magazines, ref);
+}
+
+// the stacks of a terminating thread remain cached in the depot
+void destroy_thread_cache( void * vp)
+{
+    thread_cache * tc = static_cast< thread_cache * >( vp);
+    for ( std::size_t k = 0; k < size_classes; ++k)
+    {
+        return_magazine( k, tc->loaded[k]);
+        return_magazine( k, tc->previous[k]);
+    }
+    delete tc;
+}
+
+pthread_key_t   cache_key;
+pthread_once_t  cache_once = PTHREAD_ONCE_INIT;
+
+void create_cache_key()
+{
+#if defined(BOOST_DISABLE_ASSERTS)
+    ::pthread_key_create( & cache_key, destroy_thread_cache);
+#else
+    const int result = ::pthread_key_create( & cache_key, destroy_thread_cache);
+    BOOST_ASSERT( 0 == result);
+#endif
+}
+
+thread_cache * cache()
+{
+    ::pthread_once( & cache_once, create_cache_key);
+    thread_cache * tc = static_cast< thread_cache * >( ::pthread_getspecific( cache_key) );
+    if ( ! tc)
+    {
+        tc = new thread_cache();
+        ::pthread_setspecific( cache_key, tc);
+    }
+    return tc;
+}
+
+bool take( thread_cache * tc, std::size_t k, void *& sp)
+{
+    if ( tc->loaded[k] && 0 < magazine_at( tc->loaded[k]).count)
+    {
+        magazine & m = magazine_at( tc->loaded[k]);
+        sp = m.stacks[--m.count];
+        return true;
+    }
+    if ( tc->previous[k] && 0 < magazine_at( tc->previous[k]).count)
+        std::swap( tc->loaded[k], tc->previous[k]);
+    else
+    {
+        // exchange the empty magazine for a full one from the depot
+        const uint32_t full = pop( full_magazines[k]);
+        if ( 0 == full) return false;
+        if ( tc->previous[k]) push( empty_magazines, tc->previous[k]);
+        tc->previous[k] = tc->loaded[k];
+        tc->loaded[k] = full;
+    }
+    magazine & m = magazine_at( tc->loaded[k]);
+    sp = m.stacks[--m.count];
+    return true;
+}
+
+bool put( thread_cache * tc, std::size_t k, void * sp)
+{
+    if ( ! tc->loaded[k] || magazine_size == magazine_at( tc->loaded[k]).count)
+    {
+        if ( tc->previous[k] && magazine_size > magazine_at( tc->previous[k]).count)
+            std::swap( tc->loaded[k], tc->previous[k]);
+        else
+        {
+            // hand the full magazine over to the depot
+            uint32_t empty = pop( empty_magazines);
+            if ( 0 == empty) empty = create_magazine();
+            if ( 0 == empty) return false;
+            if ( tc->previous[k]) push( full_magazines[k], tc->previous[k]);
+            tc->previous[k] = tc->loaded[k];
+            tc->loaded[k] = empty;
+        }
+    }
+    magazine & m = magazine_at( tc->loaded[k]);
+    m.stacks[m.count++] = sp;
+    return true;
+}
+
+}
+
+bool
+magazine_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+magazine_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+magazine_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+magazine_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+std::size_t
+magazine_stack_allocator::cached()
+{ return cached_stacks; }
+
+void
+magazine_stack_allocator::trim( std::size_t keep)
+{
+    for ( std::size_t k = 0; k < size_classes && keep < cached_stacks; ++k)
+    {
+        uint32_t ref = 0;
+        while ( keep < cached_stacks && 0 != ( ref = pop( full_magazines[k]) ) )
+        {
+            magazine & m = magazine_at( ref);
+            while ( 0 < m.count && keep < cached_stacks)
+            {
+                stack_context ctx( stack_of( k, m.stacks[--m.count]) );
+                unmap_stack( ctx);
+                __sync_sub_and_fetch( & cached_stacks, 1);
+            }
+            return_magazine( k, ref);
+        }
+    }
+}
+
+void
+magazine_stack_allocator::purge()
+{
+    thread_cache * tc = cache();
+    for ( std::size_t k = 0; k < size_classes; ++k)
+    {
+        uint32_t refs[] = { tc->loaded[k], tc->previous[k] };
+        for ( std::size_t i = 0; i < 2; ++i)
+        {
+            if ( 0 == refs[i]) continue;
+            magazine & m = magazine_at( refs[i]);
+            while ( 0 < m.count)
+            {
+                stack_context ctx( stack_of( k, m.stacks[--m.count]) );
+                unmap_stack( ctx);
+                __sync_sub_and_fetch( & cached_stacks, 1);
+            }
+        }
+    }
+}
+
+magazine_stack_allocator::magazine_stack_allocator( std::size_t max_cached) :
+    max_cached_( max_cached)
+{}
+
+void
+magazine_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    const std::size_t k( size_class_of_request( size) );
+    if ( ! is_poolable( k) )
+    {
+        standard_stack_allocator().allocate( ctx, size);
+        return;
+    }
+
+    void * sp = 0;
+    const bool hit( take( cache(), k, sp) );
+    record_pool_lookup( hit);
+    if ( hit)
+    {
+        __sync_sub_and_fetch( & cached_stacks, 1);
+        ctx = stack_of( k, sp);
+        record_stack_allocated();
+        return;
+    }
+    standard_stack_allocator().allocate( ctx, ( std::size_t( 1) << k) * pagesize() );
+}
+
+void
+magazine_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    const std::size_t k( size_class_of_stack( ctx) );
+    // the bound is checked without synchronization - it might be exceeded
+    // by a few stacks
+    if ( is_poolable( k) && cached_stacks < max_cached_ && put( cache(), k, ctx.sp) )
+    {
+        __sync_add_and_fetch( & cached_stacks, 1);
+        record_stack_deallocated();
+        return;
+    }
+    standard_stack_allocator().deallocate( ctx);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
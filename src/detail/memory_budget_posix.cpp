@@ -0,0 +1,102 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/memory_budget.hpp"
+
+extern "C" {
+#include <pthread.h>
+}
+
+#include <cstddef>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/exceptions.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+volatile std::size_t    limit_ = 0;
+volatile std::size_t    used_ = 0;
+// threads blocked in charge_memory_budget()
+volatile std::size_t    waiters = 0;
+pthread_mutex_t         mtx = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t          cond = PTHREAD_COND_INITIALIZER;
+
+bool try_charge( std::size_t bytes)
+{
+    for (;;)
+    {
+        const std::size_t used = used_;
+        const std::size_t limit = limit_;
+        if ( 0 != limit && used + bytes > limit) return false;
+        if ( __sync_bool_compare_and_swap( & used_, used, used + bytes) ) return true;
+    }
+}
+
+void wake_waiters()
+{
+    // the waiter increments `waiters` before it checks the budget again
+    if ( 0 == waiters) return;
+    mutex_guard lk( & mtx);
+    ::pthread_cond_broadcast( & cond);
+}
+
+}
+
+void set_memory_budget( std::size_t bytes)
+{
+    limit_ = bytes;
+    __sync_synchronize();
+    wake_waiters();
+}
+
+std::size_t memory_budget_limit()
+{ return limit_; }
+
+std::size_t memory_budget_used()
+{ return used_; }
+
+std::size_t memory_budget_waiting()
+{ return waiters; }
+
+void charge_memory_budget( std::size_t bytes, bool wait)
+{
+    if ( try_charge( bytes) ) return;
+    // would wait forever
+    if ( ! wait || bytes > limit_) throw memory_budget_exceeded();
+
+    mutex_guard lk( & mtx);
+    __sync_add_and_fetch( & waiters, 1);
+    while ( ! try_charge( bytes) )
+    {
+        if ( 0 != limit_ && bytes > limit_)
+        {
+            __sync_sub_and_fetch( & waiters, 1);
+            throw memory_budget_exceeded();
+        }
+        ::pthread_cond_wait( & cond, & mtx);
+    }
+    __sync_sub_and_fetch( & waiters, 1);
+}
+
+void release_memory_budget( std::size_t bytes) BOOST_NOEXCEPT
+{
+    __sync_sub_and_fetch( & used_, bytes);
+    wake_waiters();
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
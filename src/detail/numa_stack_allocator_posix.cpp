@@ -0,0 +1,423 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/numa_stack_allocator.hpp"
+
+extern "C" {
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+}
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// blocks of numa_allocate() are multiples of the block size carved from
+// chunks aligned to their size; the first block of a chunk stores its node
+const std::size_t block_size = 64;
+const std::size_t block_classes = 32;
+const std::size_t chunk_size = 64 * 1024;
+
+// a cached stack (block) is linked into the free list by a pointer
+// stored at the top of its (unused) memory, followed by the policy of
+// the stack
+inline
+void * & next_of( void * sp)
+{ return * ( static_cast< void ** >( sp) - 1); }
+
+inline
+flag_numa_t & policy_of( void * sp)
+{ return * reinterpret_cast< flag_numa_t * >( static_cast< void ** >( sp) - 2); }
+
+inline
+void * & next_block( void * p)
+{ return * static_cast< void ** >( p); }
+
+struct node_pool
+{
+    pthread_mutex_t     mtx;
+    void            *   head[size_classes];
+    std::size_t         count[size_classes];
+    void            *   blocks[block_classes];
+    char            *   chunk_next;
+    char            *   chunk_end;
+
+    node_pool() :
+        chunk_next( 0), chunk_end( 0)
+    {
+        ::pthread_mutex_init( & mtx, 0);
+        for ( std::size_t i = 0; i < size_classes; ++i)
+        {
+            head[i] = 0;
+            count[i] = 0;
+        }
+        for ( std::size_t i = 0; i < block_classes; ++i)
+            blocks[i] = 0;
+    }
+
+    bool pop( std::size_t k, stack_context & ctx, flag_numa_t & policy)
+    {
+        if ( ! head[k]) return false;
+
+        ctx.sp = head[k];
+        ctx.size = ( ( std::size_t( 1) << k) + 1) * pagesize();
+        head[k] = next_of( ctx.sp);
+        policy = policy_of( ctx.sp);
+        --count[k];
+        return true;
+    }
+
+    void push( std::size_t k, stack_context const& ctx, flag_numa_t policy)
+    {
+        next_of( ctx.sp) = head[k];
+        policy_of( ctx.sp) = policy;
+        head[k] = ctx.sp;
+        ++count[k];
+    }
+};
+
+std::size_t nodes_()
+{
+    std::size_t n = 1;
+#if defined(__linux__)
+    // list of node ranges, e.g. "0" or "0-1,3"
+    std::FILE * f = std::fopen( "/sys/devices/system/node/possible", "r");
+    if ( ! f) return n;
+    std::size_t value = 0;
+    bool digits = false;
+    for ( int c = std::fgetc( f); ; c = std::fgetc( f) )
+    {
+        if ( '0' <= c && '9' >= c)
+        {
+            value = value * 10 + ( c - '0');
+            digits = true;
+            continue;
+        }
+        if ( digits && value + 1 > n) n = value + 1;
+        value = 0;
+        digits = false;
+        if ( EOF == c) break;
+    }
+    std::fclose( f);
+#endif
+    return n;
+}
+
+pthread_once_t  pools_once = PTHREAD_ONCE_INIT;
+node_pool   *   pools_ = 0;
+
+void create_pools()
+{ pools_ = new node_pool[numa_stack_allocator::nodes()]; }
+
+node_pool & pool( std::size_t node)
+{
+    ::pthread_once( & pools_once, create_pools);
+    BOOST_ASSERT( node < numa_stack_allocator::nodes() );
+    return pools_[node];
+}
+
+pthread_mutex_t stacks_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+struct binding
+{
+    std::size_t     node;
+    flag_numa_t     policy;
+
+    binding( std::size_t node_, flag_numa_t policy_) :
+        node( node_), policy( policy_)
+    {}
+};
+
+// binding of the allocated stacks, by stack pointer
+std::map< void *, binding > & stacks()
+{
+    static std::map< void *, binding > * m =
+        new std::map< void *, binding >();
+    return * m;
+}
+
+binding binding_of( void * sp)
+{
+    mutex_guard lk( & stacks_mtx);
+    std::map< void *, binding >::const_iterator i( stacks().find( sp) );
+    BOOST_ASSERT( stacks().end() != i);
+    return i->second;
+}
+
+// binding is a hint - failures (kernel without NUMA support, policy not
+// permitted) are ignored
+void bind_memory( void * addr, std::size_t len, std::size_t node, flag_numa_t policy)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    const std::size_t bits( sizeof( unsigned long) * 8);
+    std::vector< unsigned long > mask( node / bits + 1, 0);
+    mask[node / bits] |= 1UL << ( node % bits);
+    // MPOL_PREFERRED, MPOL_BIND of <numaif.h>
+    const int mode = numa_bound == policy ? 2 : 1;
+    ::syscall( SYS_mbind, addr, len, mode, & mask[0], mask.size() * bits + 1, 0);
+#else
+    ( void) addr; ( void) len; ( void) node; ( void) policy;
+#endif
+}
+
+void bind_stack( stack_context const& ctx, std::size_t node, flag_numa_t policy)
+{ bind_memory( static_cast< char * >( ctx.sp) - ctx.size + pagesize(), ctx.size - pagesize(), node, policy); }
+
+void release_stack( stack_context & ctx)
+{
+    {
+        mutex_guard lk( & stacks_mtx);
+        stacks().erase( ctx.sp);
+    }
+    unmap_stack( ctx);
+}
+
+std::size_t round_up( std::size_t n, std::size_t align)
+{ return ( n + align - 1) / align * align; }
+
+char * map_bound( std::size_t len, std::size_t node)
+{
+    void * vp = ::mmap( 0, len, PROT_READ | PROT_WRITE, stack_map_flags(), -1, 0);
+    if ( MAP_FAILED == vp) throw std::bad_alloc();
+    bind_memory( vp, len, node, numa_preferred);
+    return static_cast< char * >( vp);
+}
+
+// a chunk aligned to chunk_size, bound to `node`
+char * allocate_chunk( std::size_t node)
+{
+    char * region = static_cast< char * >(
+        ::mmap( 0, 2 * chunk_size, PROT_READ | PROT_WRITE, stack_map_flags(), -1, 0) );
+    if ( MAP_FAILED == static_cast< void * >( region) ) throw std::bad_alloc();
+    char * chunk = reinterpret_cast< char * >(
+        round_up( reinterpret_cast< uintptr_t >( region), chunk_size) );
+    if ( region < chunk) ::munmap( region, chunk - region);
+    if ( chunk + chunk_size < region + 2 * chunk_size)
+        ::munmap( chunk + chunk_size, region + 2 * chunk_size - ( chunk + chunk_size) );
+    bind_memory( chunk, chunk_size, node, numa_preferred);
+    * reinterpret_cast< std::size_t * >( chunk) = node;
+    return chunk;
+}
+
+}
+
+bool
+numa_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+numa_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+numa_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+numa_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+std::size_t
+numa_stack_allocator::nodes()
+{
+    static std::size_t n = nodes_();
+    return n;
+}
+
+std::size_t
+numa_stack_allocator::current_node()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned int cpu = 0, node = 0;
+    if ( 0 == ::syscall( SYS_getcpu, & cpu, & node, 0) && node < nodes() )
+        return node;
+#endif
+    return 0;
+}
+
+std::size_t
+numa_stack_allocator::node_of( stack_context const& ctx)
+{ return binding_of( ctx.sp).node; }
+
+std::size_t
+numa_stack_allocator::cached( std::size_t node)
+{
+    node_pool & p( pool( node) );
+    mutex_guard lk( & p.mtx);
+    std::size_t n = 0;
+    for ( std::size_t k = 0; k < size_classes; ++k)
+        n += p.count[k];
+    return n;
+}
+
+void
+numa_stack_allocator::purge()
+{
+    for ( std::size_t node = 0; node < nodes(); ++node)
+    {
+        std::vector< stack_context > released;
+        {
+            node_pool & p( pool( node) );
+            mutex_guard lk( & p.mtx);
+            for ( std::size_t k = 0; k < size_classes; ++k)
+            {
+                stack_context ctx;
+                flag_numa_t policy;
+                while ( p.pop( k, ctx, policy) )
+                    released.push_back( ctx);
+            }
+        }
+        for ( std::size_t i = 0; i < released.size(); ++i)
+            release_stack( released[i]);
+    }
+}
+
+numa_stack_allocator::numa_stack_allocator( std::size_t max_cached, flag_numa_t policy) :
+    max_cached_( max_cached),
+    policy_( policy)
+{}
+
+void
+numa_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    const std::size_t node( current_node() );
+    const std::size_t k( size_class_of_request( size) );
+    if ( is_poolable( k) )
+    {
+        flag_numa_t policy = policy_;
+        bool hit;
+        {
+            node_pool & p( pool( node) );
+            mutex_guard lk( & p.mtx);
+            hit = p.pop( k, ctx, policy);
+        }
+        record_pool_lookup( hit);
+        if ( hit)
+        {
+            // cached by an allocator with the other policy
+            if ( policy != policy_)
+            {
+                bind_stack( ctx, node, policy_);
+                mutex_guard lk( & stacks_mtx);
+                detail::stacks().find( ctx.sp)->second.policy = policy_;
+            }
+            record_stack_allocated();
+            return;
+        }
+    }
+
+    standard_stack_allocator().allocate(
+        ctx, is_poolable( k) ? ( std::size_t( 1) << k) * pagesize() : size);
+    // the pages are not touched yet - they are placed on `node` at first access
+    bind_stack( ctx, node, policy_);
+
+    mutex_guard lk( & stacks_mtx);
+    detail::stacks().insert( std::make_pair( ctx.sp, binding( node, policy_) ) );
+}
+
+void
+numa_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    const binding b( binding_of( ctx.sp) );
+    const std::size_t k( size_class_of_stack( ctx) );
+    if ( is_poolable( k) )
+    {
+        node_pool & p( pool( b.node) );
+        mutex_guard lk( & p.mtx);
+        if ( p.count[k] < max_cached_)
+        {
+            p.push( k, ctx, b.policy);
+            record_stack_deallocated();
+            return;
+        }
+    }
+    record_stack_deallocated();
+    release_stack( ctx);
+}
+
+void * numa_allocate( std::size_t size)
+{
+    if ( 0 == size) size = 1;
+    const std::size_t node( numa_stack_allocator::current_node() );
+    if ( block_classes * block_size < size)
+        return map_bound( round_up( size, pagesize() ), node);
+
+    const std::size_t c( ( size + block_size - 1) / block_size - 1);
+    node_pool & p( pool( node) );
+    mutex_guard lk( & p.mtx);
+    void * block = p.blocks[c];
+    if ( block)
+    {
+        p.blocks[c] = next_block( block);
+        return block;
+    }
+    const std::size_t len( ( c + 1) * block_size);
+    if ( ! p.chunk_next || static_cast< std::size_t >( p.chunk_end - p.chunk_next) < len)
+    {
+        // the rest of the previous chunk is lost
+        char * chunk = allocate_chunk( node);
+        p.chunk_next = chunk + block_size;
+        p.chunk_end = chunk + chunk_size;
+    }
+    block = p.chunk_next;
+    p.chunk_next += len;
+    return block;
+}
+
+void numa_deallocate( void * vp, std::size_t size) BOOST_NOEXCEPT
+{
+    if ( ! vp) return;
+    if ( 0 == size) size = 1;
+    if ( block_classes * block_size < size)
+    {
+        ::munmap( vp, round_up( size, pagesize() ) );
+        return;
+    }
+
+    // the block returns to the node its chunk is bound to
+    const std::size_t node( * reinterpret_cast< std::size_t * >(
+        reinterpret_cast< uintptr_t >( vp) & ~( uintptr_t( chunk_size) - 1) ) );
+    const std::size_t c( ( size + block_size - 1) / block_size - 1);
+    node_pool & p( pool( node) );
+    mutex_guard lk( & p.mtx);
+    next_block( vp) = p.blocks[c];
+    p.blocks[c] = vp;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
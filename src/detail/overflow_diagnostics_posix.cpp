@@ -0,0 +1,292 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/overflow_diagnostics.hpp"
+
+extern "C" {
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// stack of a coroutine, read by the signal handler without locking;
+// records are never freed but reused for new coroutines
+struct overflow_record
+{
+    char * volatile         limit;      // lowest address (guard page), 0 if not in use
+    std::size_t             stacksize;  // stack_context::size
+    std::size_t             size;       // attributes::size
+    char const          *   site;
+    char                    label[64];
+    overflow_record     *   next;       // all records
+    overflow_record     *   next_free;
+};
+
+overflow_record * volatile  records = 0;
+overflow_record         *   free_records = 0;
+pthread_mutex_t             records_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+volatile bool               enabled = false;
+volatile int                report_fd = 2;
+volatile sig_atomic_t       chaining = 0;
+struct sigaction            previous_segv;
+struct sigaction            previous_bus;
+
+// async-signal-safe formatting
+class report
+{
+private:
+    char            buffer_[512];
+    std::size_t     size_;
+
+public:
+    report() :
+        size_( 0)
+    {}
+
+    report & operator<<( char const* s)
+    {
+        for ( ; s && * s && size_ < sizeof( buffer_); ++s)
+            buffer_[size_++] = * s;
+        return * this;
+    }
+
+    report & operator<<( std::size_t n)
+    {
+        char digits[24];
+        std::size_t i = 0;
+        do
+        {
+            digits[i++] = static_cast< char >( '0' + n % 10);
+            n /= 10;
+        }
+        while ( 0 != n);
+        while ( 0 < i && size_ < sizeof( buffer_) )
+            buffer_[size_++] = digits[--i];
+        return * this;
+    }
+
+    report & operator<<( void const* p)
+    {
+        std::size_t n = reinterpret_cast< std::size_t >( p);
+        char digits[2 * sizeof( std::size_t)];
+        std::size_t i = 0;
+        do
+        {
+            digits[i++] = "0123456789abcdef"[n % 16];
+            n /= 16;
+        }
+        while ( 0 != n);
+        * this << "0x";
+        while ( 0 < i && size_ < sizeof( buffer_) )
+            buffer_[size_++] = digits[--i];
+        return * this;
+    }
+
+    void write( int fd) const
+    {
+        char const* p = buffer_;
+        std::size_t left = size_;
+        while ( 0 < left)
+        {
+            const ssize_t n = ::write( fd, p, left);
+            if ( 0 >= n) return;
+            p += n;
+            left -= n;
+        }
+    }
+};
+
+void report_overflow( int sig, siginfo_t * info, void * uctx)
+{
+    // handlers chaining to each other (the previous handler was installed
+    // again on top of this one)
+    if ( chaining)
+    {
+        ::signal( sig, SIG_DFL);
+        return;
+    }
+
+    char * addr = static_cast< char * >( info->si_addr);
+    for ( overflow_record * r = records; r; r = r->next)
+    {
+        char * limit = r->limit;
+        if ( ! limit || addr < limit || limit + pagesize() <= addr) continue;
+
+        report rep;
+        rep << "boost.coroutine: stack overflow of coroutine";
+        if ( r->label[0]) rep << " '" << r->label << "'";
+        if ( r->site) rep << " created for " << r->site;
+        rep << ": attributes::size " << r->size
+            << ", stack of " << r->stacksize - pagesize() << " bytes at "
+            << static_cast< void * >( limit + pagesize() )
+            << ", fault at " << static_cast< void * >( addr) << "\n";
+        rep.write( report_fd);
+        break;
+    }
+
+    chaining = 1;
+    chain_signal( SIGSEGV == sig ? previous_segv : previous_bus, sig, info, uctx);
+    chaining = 0;
+}
+
+void install_handler( int sig, struct sigaction & previous)
+{
+    struct sigaction current;
+    ::sigaction( sig, 0, & current);
+    if ( ( current.sa_flags & SA_SIGINFO) && report_overflow == current.sa_sigaction)
+        return;
+
+    struct sigaction action;
+    action.sa_sigaction = report_overflow;
+    ::sigemptyset( & action.sa_mask);
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    ::sigaction( sig, & action, & previous);
+}
+
+pthread_key_t   altstack_key;
+pthread_once_t  altstack_once = PTHREAD_ONCE_INIT;
+
+void release_altstack( void * vp)
+{
+    stack_t ss;
+    ss.ss_sp = 0;
+    ss.ss_size = 0;
+    ss.ss_flags = SS_DISABLE;
+    ::sigaltstack( & ss, 0);
+    std::free( vp);
+}
+
+void create_altstack_key()
+{
+#if defined(BOOST_DISABLE_ASSERTS)
+    ::pthread_key_create( & altstack_key, release_altstack);
+#else
+    const int result = ::pthread_key_create( & altstack_key, release_altstack);
+    BOOST_ASSERT( 0 == result);
+#endif
+}
+
+}
+
+void chain_signal( struct sigaction const& previous, int sig, siginfo_t * info, void * uctx)
+{
+    if ( previous.sa_flags & SA_SIGINFO)
+        previous.sa_sigaction( sig, info, uctx);
+    else if ( SIG_DFL == previous.sa_handler || SIG_IGN == previous.sa_handler)
+    {
+        // the faulting instruction is executed again and raises the default action
+        ::signal( sig, SIG_DFL);
+    }
+    else
+        previous.sa_handler( sig);
+}
+
+void prepare_signal_stack()
+{
+    ::pthread_once( & altstack_once, create_altstack_key);
+    if ( ::pthread_getspecific( altstack_key) ) return;
+
+    stack_t ss;
+    ::sigaltstack( 0, & ss);
+    // an alternate signal stack installed by the application is used as well
+    if ( 0 == ( ss.ss_flags & SS_DISABLE) ) return;
+
+    const std::size_t size = ( std::max)( std::size_t( SIGSTKSZ), std::size_t( 64 * 1024) );
+    void * vp = std::malloc( size);
+    if ( ! vp) throw std::bad_alloc();
+    ss.ss_sp = vp;
+    ss.ss_size = size;
+    ss.ss_flags = 0;
+    if ( 0 != ::sigaltstack( & ss, 0) )
+    {
+        std::free( vp);
+        throw std::bad_alloc();
+    }
+    ::pthread_setspecific( altstack_key, vp);
+}
+
+void enable_overflow_diagnostics( int fd)
+{
+    prepare_signal_stack();
+
+    mutex_guard lk( & records_mtx);
+    report_fd = fd;
+    install_handler( SIGSEGV, previous_segv);
+    install_handler( SIGBUS, previous_bus);
+    enabled = true;
+}
+
+void * register_overflow_stack(
+        stack_context const& ctx, std::size_t size, char const* label, char const* site)
+{
+    if ( ! enabled) return 0;
+
+    prepare_signal_stack();
+
+    mutex_guard lk( & records_mtx);
+    overflow_record * r = free_records;
+    const bool fresh( ! r);
+    if ( fresh)
+    {
+        r = new overflow_record();
+        r->next = records;
+    }
+    else
+        free_records = r->next_free;
+    r->next_free = 0;
+    r->stacksize = ctx.size;
+    r->size = size;
+    r->site = site;
+    r->label[0] = '\0';
+    if ( label) std::strncat( r->label, label, sizeof( r->label) - 1);
+    __sync_synchronize();
+    r->limit = static_cast< char * >( ctx.sp) - ctx.size;
+    if ( fresh)
+    {
+        __sync_synchronize();
+        records = r;
+    }
+    return r;
+}
+
+void unregister_overflow_stack( void * vp) BOOST_NOEXCEPT
+{
+    if ( ! vp) return;
+
+    overflow_record * r = static_cast< overflow_record * >( vp);
+    mutex_guard lk( & records_mtx);
+    r->limit = 0;
+    r->next_free = free_records;
+    free_records = r;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
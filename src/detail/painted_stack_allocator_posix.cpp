@@ -0,0 +1,213 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/painted_stack_allocator.hpp"
+
+extern "C" {
+#include <dlfcn.h>
+}
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+const unsigned char paint = 0xcd;
+
+typedef std::map< std::string, stack_usage >    sites_t;
+
+struct painted_stack
+{
+    sites_t::iterator   site;
+    std::size_t         size;
+};
+
+typedef std::map< void *, painted_stack >       stacks_t;
+
+pthread_mutex_t painted_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+sites_t & sites()
+{
+    static sites_t * m = new sites_t();
+    return * m;
+}
+
+typedef std::map< void const*, std::string >   functions_t;
+
+functions_t & functions()
+{
+    static functions_t * m = new functions_t();
+    return * m;
+}
+
+stacks_t & stacks()
+{
+    static stacks_t * m = new stacks_t();
+    return * m;
+}
+
+// the lowest page is not painted - it might be a guard page
+char * painted_begin( stack_context const& ctx)
+{ return static_cast< char * >( ctx.sp) - ctx.size + pagesize(); }
+
+std::size_t used_( stack_context const& ctx)
+{
+    BOOST_ASSERT( 2 * pagesize() <= ctx.size);
+
+    char * top = static_cast< char * >( ctx.sp);
+    char * p = painted_begin( ctx);
+    while ( p < top && paint == static_cast< unsigned char >( * p) ) ++p;
+    return top - p;
+}
+
+void update_live( sites_t::iterator site)
+{
+    for ( stacks_t::const_iterator i = stacks().begin(); i != stacks().end(); ++i)
+    {
+        if ( site != i->second.site) continue;
+        stack_context ctx;
+        ctx.sp = i->first;
+        ctx.size = i->second.size;
+        const std::size_t n( used_( ctx) );
+        if ( site->second.max_used < n) site->second.max_used = n;
+    }
+}
+
+}
+
+void paint_stack( stack_context const& ctx, char const* site)
+{
+    BOOST_ASSERT( ctx.sp);
+    BOOST_ASSERT( site);
+    BOOST_ASSERT( 2 * pagesize() <= ctx.size);
+
+    char * begin = painted_begin( ctx);
+    std::memset( begin, paint, static_cast< char * >( ctx.sp) - begin);
+
+    mutex_guard lk( & painted_mtx);
+    sites_t::iterator i( sites().insert( std::make_pair( std::string( site), stack_usage() ) ).first);
+    ++i->second.stacks;
+    ++i->second.live;
+    if ( i->second.size < ctx.size) i->second.size = ctx.size;
+    painted_stack & stack( stacks()[ctx.sp]);
+    stack.site = i;
+    stack.size = ctx.size;
+}
+
+void unpaint_stack( stack_context const& ctx)
+{
+    const std::size_t n( used_( ctx) );
+
+    mutex_guard lk( & painted_mtx);
+    stacks_t::iterator i( stacks().find( ctx.sp) );
+    BOOST_ASSERT( stacks().end() != i);
+    stack_usage & usage( i->second.site->second);
+    --usage.live;
+    if ( usage.max_used < n) usage.max_used = n;
+    stacks().erase( i);
+}
+
+std::size_t painted_stack_used( stack_context const& ctx)
+{ return used_( ctx); }
+
+stack_usage painted_stack_usage( char const* site)
+{
+    mutex_guard lk( & painted_mtx);
+    sites_t::iterator i( sites().find( std::string( site) ) );
+    if ( sites().end() == i) return stack_usage();
+    update_live( i);
+    return i->second;
+}
+
+void painted_stack_report( std::ostream & os)
+{
+    mutex_guard lk( & painted_mtx);
+    for ( sites_t::iterator i = sites().begin(); i != sites().end(); ++i)
+    {
+        update_live( i);
+        os << "'" << i->first << "': stacks " << i->second.stacks
+           << ", live " << i->second.live
+           << ", size " << i->second.size
+           << ", max used " << i->second.max_used << "\n";
+    }
+}
+
+std::size_t painted_stack_peak( char const* site)
+{
+    mutex_guard lk( & painted_mtx);
+    sites_t::const_iterator i( sites().find( std::string( site) ) );
+    return sites().end() == i ? 0 : i->second.max_used;
+}
+
+// the name of an exported function, otherwise the type of the function and its
+// offset in the binary (stable across runs - usable by painted_stack_load())
+char const* function_site( char const* type, void const* fn)
+{
+    if ( ! fn) return type;
+
+    mutex_guard lk( & painted_mtx);
+    functions_t::iterator i( functions().find( fn) );
+    if ( functions().end() != i) return i->second.c_str();
+
+    std::ostringstream os;
+    Dl_info info;
+    if ( 0 == ::dladdr( const_cast< void * >( fn), & info) || ! info.dli_fname)
+        os << type << "@" << fn;
+    else if ( info.dli_sname && fn == info.dli_saddr)
+        os << info.dli_sname;
+    else
+        os << type << "+0x" << std::hex
+           << reinterpret_cast< uintptr_t >( fn) - reinterpret_cast< uintptr_t >( info.dli_fbase)
+           << " " << info.dli_fname;
+    return functions().insert( std::make_pair( fn, os.str() ) ).first->second.c_str();
+}
+
+// one line per site: "<max used> <site>"
+void painted_stack_save( std::ostream & os)
+{
+    mutex_guard lk( & painted_mtx);
+    for ( sites_t::iterator i = sites().begin(); i != sites().end(); ++i)
+    {
+        update_live( i);
+        os << i->second.max_used << " " << i->first << "\n";
+    }
+}
+
+void painted_stack_load( std::istream & is)
+{
+    mutex_guard lk( & painted_mtx);
+    std::size_t max_used = 0;
+    std::string site;
+    while ( is >> max_used && std::getline( is >> std::ws, site) )
+    {
+        stack_usage & usage( sites()[site]);
+        if ( usage.max_used < max_used) usage.max_used = max_used;
+    }
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -0,0 +1,211 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/pooled_stack_allocator.hpp"
+
+extern "C" {
+#include <pthread.h>
+}
+
+#include <cstddef>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// a cached stack is linked into the free list by a pointer
+// stored at the top of its (unused) memory
+inline
+void * & next_of( void * sp)
+{ return * ( static_cast< void ** >( sp) - 1); }
+
+struct stack_pool
+{
+    void        *   head[size_classes];
+    std::size_t     count[size_classes];
+
+    stack_pool()
+    {
+        for ( std::size_t i = 0; i < size_classes; ++i)
+        {
+            head[i] = 0;
+            count[i] = 0;
+        }
+    }
+
+    bool pop( std::size_t k, stack_context & ctx)
+    {
+        if ( ! head[k]) return false;
+
+        ctx.sp = head[k];
+        ctx.size = ( ( std::size_t( 1) << k) + 1) * pagesize();
+        head[k] = next_of( ctx.sp);
+        --count[k];
+        return true;
+    }
+
+    void push( std::size_t k, stack_context const& ctx)
+    {
+        next_of( ctx.sp) = head[k];
+        head[k] = ctx.sp;
+        ++count[k];
+    }
+
+    void clear()
+    {
+        for ( std::size_t k = 0; k < size_classes; ++k)
+        {
+            stack_context ctx;
+            while ( pop( k, ctx) )
+                unmap_stack( ctx);
+        }
+    }
+};
+
+pthread_key_t   pool_key;
+pthread_once_t  pool_once = PTHREAD_ONCE_INIT;
+
+void destroy_pool( void * vp)
+{
+    stack_pool * p = static_cast< stack_pool * >( vp);
+    p->clear();
+    delete p;
+}
+
+void create_pool_key()
+{
+#if defined(BOOST_DISABLE_ASSERTS)
+    ::pthread_key_create( & pool_key, destroy_pool);
+#else
+    const int result = ::pthread_key_create( & pool_key, destroy_pool);
+    BOOST_ASSERT( 0 == result);
+#endif
+}
+
+stack_pool * pool()
+{
+    ::pthread_once( & pool_once, create_pool_key);
+    stack_pool * p = static_cast< stack_pool * >( ::pthread_getspecific( pool_key) );
+    if ( ! p)
+    {
+        p = new stack_pool();
+        ::pthread_setspecific( pool_key, p);
+    }
+    return p;
+}
+
+}
+
+bool
+pooled_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+pooled_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+pooled_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+pooled_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+std::size_t
+pooled_stack_allocator::cached()
+{
+    stack_pool * p( pool() );
+    std::size_t n = 0;
+    for ( std::size_t k = 0; k < size_classes; ++k)
+        n += p->count[k];
+    return n;
+}
+
+void
+pooled_stack_allocator::purge()
+{ pool()->clear(); }
+
+pooled_stack_allocator::pooled_stack_allocator( std::size_t max_cached) :
+    max_cached_( max_cached)
+{}
+
+void
+pooled_stack_allocator::prewarm( std::size_t size, std::size_t count)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+
+    const std::size_t k( size_class_of_request( size) );
+    if ( ! is_poolable( k) ) return;
+
+    stack_pool * p( pool() );
+    while ( p->count[k] < count && p->count[k] < max_cached_)
+    {
+        stack_context ctx;
+        map_stack( ctx, ( std::size_t( 1) << k) * pagesize() );
+        p->push( k, ctx);
+    }
+}
+
+void
+pooled_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    const std::size_t k( size_class_of_request( size) );
+    if ( ! is_poolable( k) )
+    {
+        standard_stack_allocator().allocate( ctx, size);
+        return;
+    }
+
+    const bool hit( pool()->pop( k, ctx) );
+    record_pool_lookup( hit);
+    if ( hit)
+    {
+        record_stack_allocated();
+        return;
+    }
+    standard_stack_allocator().allocate( ctx, ( std::size_t( 1) << k) * pagesize() );
+}
+
+void
+pooled_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    const std::size_t k( size_class_of_stack( ctx) );
+    if ( is_poolable( k) )
+    {
+        stack_pool * p( pool() );
+        if ( p->count[k] < max_cached_)
+        {
+            p->push( k, ctx);
+            record_stack_deallocated();
+            return;
+        }
+    }
+    standard_stack_allocator().deallocate( ctx);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
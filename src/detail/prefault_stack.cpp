@@ -0,0 +1,71 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/prefault_stack.hpp"
+
+#if defined(BOOST_WINDOWS)
+extern "C" {
+#include <windows.h>
+}
+#else
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
+#include <cstddef>
+#include <new>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+void prefault_stack( stack_context const& sctx, std::size_t size, bool lock)
+{
+    BOOST_ASSERT( sctx.sp);
+
+    const uintptr_t page( pagesize() );
+    char * top = static_cast< char * >( sctx.sp);
+    // the lowest page might be a guard page
+    if ( size > sctx.size - page) size = sctx.size - page;
+    char * bottom = reinterpret_cast< char * >(
+        ( reinterpret_cast< uintptr_t >( top - size) ) & ~( page - 1) );
+    if ( bottom >= top) return;
+
+    bool populated = false;
+#if defined(MADV_POPULATE_WRITE)
+    // fails on kernels older than 5.14
+    populated = 0 == ::madvise( bottom, top - bottom, MADV_POPULATE_WRITE);
+#endif
+    if ( ! populated)
+    {
+        // writing the value read keeps the content of reused stacks
+        for ( volatile char * p = bottom; p < top; p += page)
+            * p = * p;
+    }
+
+    if ( ! lock) return;
+#if defined(BOOST_WINDOWS)
+    if ( ! ::VirtualLock( bottom, top - bottom) ) throw std::bad_alloc();
+#else
+    if ( 0 != ::mlock( bottom, top - bottom) ) throw std::bad_alloc();
+#endif
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -0,0 +1,320 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/slab_stack_allocator.hpp"
+
+extern "C" {
+#include <sys/mman.h>
+}
+
+#include <cstddef>
+#include <map>
+#include <new>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+#include <boost/coroutine/detail/standard_stack_allocator.hpp>
+#include <boost/coroutine/stack_context.hpp>
+
+// lightweight guard regions, Linux >= 6.13
+#if defined(__linux__) && ! defined(MADV_GUARD_INSTALL)
+# define MADV_GUARD_INSTALL 102
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+const std::size_t bits_per_word = sizeof( std::size_t) * 8;
+
+// memory layout of a slab:
+// [guard|stack][guard|stack] ... [guard|stack]
+// a stack_context refers to a slot as if it were allocated by
+// standard_stack_allocator (sp - size == start of the guard page); guard
+// pages not protected (guard mode) stay untouched and are never backed
+struct slab
+{
+    char                        *   base;
+    std::size_t                     slot_size;
+    std::size_t                     slots;
+    flag_guard_t                    guard;
+    std::size_t                     used;
+    std::vector< std::size_t >      bitmap;
+
+    slab( char * base_, std::size_t slot_size_, std::size_t slots_, flag_guard_t guard_) :
+        base( base_), slot_size( slot_size_), slots( slots_), guard( guard_), used( 0),
+        bitmap( ( slots_ + bits_per_word - 1) / bits_per_word, 0)
+    {}
+
+    bool full() const
+    { return slots == used; }
+
+    bool empty() const
+    { return 0 == used; }
+
+    std::size_t size() const
+    { return slots * slot_size; }
+
+    bool contains( void * vp) const
+    { return base <= vp && vp < base + size(); }
+
+    char * acquire()
+    {
+        BOOST_ASSERT( ! full() );
+
+        for ( std::size_t w = 0; w < bitmap.size(); ++w)
+        {
+            if ( ~std::size_t( 0) == bitmap[w]) continue;
+            for ( std::size_t b = 0; b < bits_per_word; ++b)
+            {
+                const std::size_t mask( std::size_t( 1) << b);
+                if ( 0 != ( bitmap[w] & mask) ) continue;
+                const std::size_t idx( w * bits_per_word + b);
+                BOOST_ASSERT( idx < slots);
+                bitmap[w] |= mask;
+                ++used;
+                return base + idx * slot_size;
+            }
+        }
+        BOOST_ASSERT_MSG( false, "no free slot in slab");
+        return 0;
+    }
+
+    void release( char * slot)
+    {
+        BOOST_ASSERT( contains( slot) );
+        BOOST_ASSERT( 0 == ( slot - base) % slot_size);
+
+        const std::size_t idx( ( slot - base) / slot_size);
+        const std::size_t mask( std::size_t( 1) << ( idx % bits_per_word) );
+        BOOST_ASSERT( 0 != ( bitmap[idx / bits_per_word] & mask) );
+        bitmap[idx / bits_per_word] &= ~mask;
+        --used;
+    }
+};
+
+pthread_mutex_t slabs_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+// all slabs ordered by their base address
+std::map< char *, slab * > & slabs()
+{
+    static std::map< char *, slab * > * m = new std::map< char *, slab * >();
+    return * m;
+}
+
+typedef std::pair< std::size_t, flag_guard_t >     slab_kind;
+
+// slabs with free slots, by slot size and guard mode
+std::map< slab_kind, std::set< slab * > > & available()
+{
+    static std::map< slab_kind, std::set< slab * > > * m =
+        new std::map< slab_kind, std::set< slab * > >();
+    return * m;
+}
+
+bool install_guard_page( char * guard)
+{
+#if defined(MADV_GUARD_INSTALL)
+    // installs the guard without changing the protection of the
+    // mapping, e.g. the mapping is not split into several VMAs
+    return 0 == ::madvise( guard, pagesize(), MADV_GUARD_INSTALL);
+#else
+    return false;
+#endif
+}
+
+bool lightweight_guards_()
+{
+    void * vp = ::mmap( 0, 2 * pagesize(), PROT_READ | PROT_WRITE, stack_map_flags(), -1, 0);
+    if ( MAP_FAILED == vp) return false;
+    const bool result( install_guard_page( static_cast< char * >( vp) ) );
+    ::munmap( vp, 2 * pagesize() );
+    return result;
+}
+
+void protect_guard_page( char * guard)
+{
+    if ( install_guard_page( guard) ) return;
+    // conforming to POSIX.1-2001
+#if defined(BOOST_DISABLE_ASSERTS)
+    ::mprotect( guard, pagesize(), PROT_NONE);
+#else
+    const int result( ::mprotect( guard, pagesize(), PROT_NONE) );
+    BOOST_ASSERT( 0 == result);
+#endif
+}
+
+slab * create_slab( std::size_t slot_size, std::size_t slots, flag_guard_t guard)
+{
+    const std::size_t size( slot_size * slots);
+    void * base = ::mmap( 0, size, PROT_READ | PROT_WRITE, stack_map_flags(), -1, 0);
+    if ( MAP_FAILED == base) throw std::bad_alloc();
+
+    slab * s = 0;
+    try
+    {
+        s = new slab( static_cast< char * >( base), slot_size, slots, guard);
+        slabs()[s->base] = s;
+    }
+    catch (...)
+    {
+        delete s;
+        ::munmap( base, size);
+        throw;
+    }
+
+    if ( guard_per_stack == guard)
+        for ( std::size_t i = 0; i < slots; ++i)
+            protect_guard_page( s->base + i * slot_size);
+    else if ( guard_per_slab == guard)
+        protect_guard_page( s->base);
+
+    name_stack_mapping( base, size, 0);
+    record_stack_mapped( base, size);
+    return s;
+}
+
+void destroy_slab( slab * s)
+{
+    slabs().erase( s->base);
+    record_stack_unmapped( s->base, s->size() );
+    ::munmap( s->base, s->size() );
+    delete s;
+}
+
+slab * find_slab( void * vp)
+{
+    std::map< char *, slab * >::iterator i(
+        slabs().upper_bound( static_cast< char * >( vp) ) );
+    if ( slabs().begin() == i) return 0;
+    --i;
+    return i->second->contains( vp) ? i->second : 0;
+}
+
+// slabs_mtx must be locked
+void release_slot( char * limit, std::size_t size)
+{
+    slab * s = find_slab( limit);
+    BOOST_ASSERT( s);
+    BOOST_ASSERT( s->slot_size == size);
+    ( void) size;
+    std::set< slab * > & avail( available()[slab_kind( s->slot_size, s->guard)]);
+    s->release( limit);
+    avail.erase( s);
+    // an empty slab is unmapped if other slabs of the same slot size
+    // have free slots
+    if ( s->empty() && ! avail.empty() )
+    {
+        destroy_slab( s);
+        return;
+    }
+    avail.insert( s);
+}
+
+}
+
+std::size_t
+release_slab_slots( slab_slot const* slots, std::size_t n)
+{
+    std::size_t calls = 0;
+    for ( std::size_t i = 0; i < n; ++calls)
+    {
+        // guard pages inside the range stay protected, MADV_DONTNEED keeps
+        // the protection and guard markers
+        char * begin = slots[i].first + pagesize();
+        char * end = slots[i].first;
+        for ( ; i < n && slots[i].first == end; ++i)
+            end += slots[i].second;
+        ::madvise( begin, end - begin, MADV_DONTNEED);
+    }
+
+    mutex_guard lk( & slabs_mtx);
+    for ( std::size_t i = 0; i < n; ++i)
+        release_slot( slots[i].first, slots[i].second);
+    return calls;
+}
+
+bool
+slab_stack_allocator::is_stack_unbound()
+{ return standard_stack_allocator::is_stack_unbound(); }
+
+std::size_t
+slab_stack_allocator::default_stacksize()
+{ return standard_stack_allocator::default_stacksize(); }
+
+std::size_t
+slab_stack_allocator::minimum_stacksize()
+{ return standard_stack_allocator::minimum_stacksize(); }
+
+std::size_t
+slab_stack_allocator::maximum_stacksize()
+{ return standard_stack_allocator::maximum_stacksize(); }
+
+bool
+slab_stack_allocator::lightweight_guards()
+{
+    static bool supported = lightweight_guards_();
+    return supported;
+}
+
+slab_stack_allocator::slab_stack_allocator( std::size_t stacks_per_slab, flag_guard_t guard) :
+    stacks_per_slab_( stacks_per_slab),
+    guard_( guard_auto != guard
+            ? guard
+            : ( lightweight_guards() ? guard_per_stack : guard_per_slab) )
+{ BOOST_ASSERT( 0 < stacks_per_slab_); }
+
+void
+slab_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    const std::size_t slot_size( ( page_count( size) + 1) * pagesize() ); // add one guard page
+
+    mutex_guard lk( & slabs_mtx);
+    std::set< slab * > & avail( available()[slab_kind( slot_size, guard_)]);
+    slab * s = avail.empty()
+        ? create_slab( slot_size, stacks_per_slab_, guard_)
+        : * avail.begin();
+    char * limit = s->acquire();
+    if ( s->full() ) avail.erase( s);
+    else avail.insert( s);
+
+    ctx.size = slot_size;
+    ctx.sp = limit + ctx.size;
+    record_stack_allocated();
+}
+
+void
+slab_stack_allocator::deallocate( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    record_stack_deallocated();
+    char * limit = static_cast< char * >( ctx.sp) - ctx.size;
+    // release the physical memory, the address range is kept
+    ::madvise( limit + pagesize(), ctx.size - pagesize(), MADV_DONTNEED);
+
+    mutex_guard lk( & slabs_mtx);
+    release_slot( limit, ctx.size);
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
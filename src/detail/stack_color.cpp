@@ -0,0 +1,55 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/stack_color.hpp"
+
+#include <cstddef>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+std::size_t stack_color_padding()
+{
+    const std::size_t page( pagesize() );
+    return page > BOOST_COROUTINES_CACHELINE_SIZE ? page - BOOST_COROUTINES_CACHELINE_SIZE : 0;
+}
+
+std::size_t color_stack( stack_context & sctx)
+{
+    BOOST_ASSERT( sctx.sp);
+
+    const std::size_t page( pagesize() );
+    const std::size_t colors( page / BOOST_COROUTINES_CACHELINE_SIZE);
+    if ( 2 > colors) return 0;
+
+    // the color is derived from the address (multiplicative hash of the page
+    // number) - stacks with sizes of a power of two get different colors too
+    const uint32_t hash( static_cast< uint32_t >(
+        reinterpret_cast< uintptr_t >( sctx.sp) / page) * UINT32_C( 2654435761) );
+    const std::size_t offset( ( hash >> 16) % colors * BOOST_COROUTINES_CACHELINE_SIZE);
+    // the lowest page might be a guard page
+    if ( sctx.size < offset + 2 * page) return 0;
+
+    sctx.sp = static_cast< char * >( sctx.sp) - offset;
+    sctx.size -= offset;
+    return offset;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -0,0 +1,97 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/detail/stack_image.hpp"
+
+#if defined(BOOST_WINDOWS)
+extern "C" {
+#include <windows.h>
+}
+#else
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// releases the pages within [begin, end) - the content is undefined afterwards
+void release_pages( char * begin, char * end)
+{
+    const uintptr_t page( pagesize() );
+    const uintptr_t first( ( reinterpret_cast< uintptr_t >( begin) + page - 1) & ~( page - 1) );
+    const uintptr_t last( reinterpret_cast< uintptr_t >( end) & ~( page - 1) );
+    if ( first >= last) return;
+
+    // failures are ignored, the pages stay resident
+#if defined(BOOST_WINDOWS)
+    ::VirtualAlloc( reinterpret_cast< void * >( first), last - first, MEM_RESET, PAGE_READWRITE);
+#else
+    ::madvise( reinterpret_cast< void * >( first), last - first, MADV_DONTNEED);
+#endif
+}
+
+}
+
+stack_image * hibernate_stack( stack_context const& sctx, void * sp)
+{
+    char * top = static_cast< char * >( sctx.sp);
+    char * bottom = top - sctx.size;
+    char * lowest = static_cast< char * >( sp);
+    BOOST_ASSERT( bottom < lowest && lowest < top);
+
+    stack_image * image = new stack_image();
+    image->top = top;
+    image->size = top - lowest;
+    try
+    { image->buffer = new char[image->size]; }
+    catch (...)
+    {
+        delete image;
+        throw;
+    }
+    std::memcpy( image->buffer, lowest, image->size);
+
+    release_pages( bottom, top);
+    return image;
+}
+
+void restore_stack( stack_image * image) BOOST_NOEXCEPT
+{
+    BOOST_ASSERT( image);
+
+    std::memcpy( image->top - image->size, image->buffer, image->size);
+    destroy_stack_image( image);
+}
+
+void destroy_stack_image( stack_image * image) BOOST_NOEXCEPT
+{
+    if ( ! image) return;
+    delete [] image->buffer;
+    delete image;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
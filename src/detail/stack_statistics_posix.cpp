@@ -0,0 +1,163 @@
+
+//          Copyright Oliver Kowalke 2009.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "boost/coroutine/stack_statistics.hpp"
+
+extern "C" {
+#include <pthread.h>
+#include <sys/mman.h>
+}
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/coroutine/detail/stack_utils.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+namespace coroutines {
+namespace detail {
+
+namespace {
+
+// counters are updated without locking
+volatile std::size_t    allocations = 0;
+volatile std::size_t    deallocations = 0;
+volatile std::size_t    live = 0;
+volatile std::size_t    peak_live = 0;
+volatile std::size_t    mapped = 0;
+volatile std::size_t    reserved = 0;
+volatile std::size_t    peak_reserved = 0;
+volatile std::size_t    pool_hits = 0;
+volatile std::size_t    pool_misses = 0;
+
+void raise_peak( volatile std::size_t & peak, std::size_t value)
+{
+    std::size_t old = peak;
+    while ( old < value)
+    {
+        const std::size_t prev = __sync_val_compare_and_swap( & peak, old, value);
+        if ( prev == old) break;
+        old = prev;
+    }
+}
+
+// ranges are registered only while residency is sampled - set and cleared
+// with the mutex held, tested without
+volatile bool           sampling = false;
+
+pthread_mutex_t mappings_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+// address ranges backing stacks mapped while sampling, by base address
+std::map< char *, std::size_t > & mappings()
+{
+    static std::map< char *, std::size_t > * m =
+        new std::map< char *, std::size_t >();
+    return * m;
+}
+
+std::size_t resident_bytes( char * base, std::size_t size)
+{
+    const std::size_t page( pagesize() );
+    std::vector< unsigned char > vec( ( size + page - 1) / page);
+    if ( 0 != ::mincore( base, size, & vec[0]) ) return 0;
+    std::size_t n = 0;
+    for ( std::size_t i = 0; i < vec.size(); ++i)
+        if ( vec[i] & 1) ++n;
+    return n * page;
+}
+
+}
+
+void record_stack_mapped( void * base, std::size_t size)
+{
+    __sync_add_and_fetch( & mapped, 1);
+    raise_peak( peak_reserved, __sync_add_and_fetch( & reserved, size) );
+    if ( __atomic_load_n( & sampling, __ATOMIC_ACQUIRE) )
+    {
+        mutex_guard lk( & mappings_mtx);
+        if ( sampling) mappings()[static_cast< char * >( base)] = size;
+    }
+}
+
+void record_stack_unmapped( void * base, std::size_t size)
+{
+    if ( __atomic_load_n( & sampling, __ATOMIC_ACQUIRE) )
+    {
+        mutex_guard lk( & mappings_mtx);
+        mappings().erase( static_cast< char * >( base) );
+    }
+    __sync_sub_and_fetch( & mapped, 1);
+    __sync_sub_and_fetch( & reserved, size);
+}
+
+void record_stack_allocated()
+{
+    __sync_add_and_fetch( & allocations, 1);
+    raise_peak( peak_live, __sync_add_and_fetch( & live, 1) );
+}
+
+void record_stack_deallocated()
+{
+    __sync_add_and_fetch( & deallocations, 1);
+    __sync_sub_and_fetch( & live, 1);
+}
+
+void record_pool_lookup( bool hit)
+{ __sync_add_and_fetch( hit ? & pool_hits : & pool_misses, 1); }
+
+void stack_statistics_sample_resident( bool enable)
+{
+    mutex_guard lk( & mappings_mtx);
+    __atomic_store_n( & sampling, enable, __ATOMIC_RELEASE);
+    if ( ! enable) mappings().clear();
+}
+
+stack_statistics stack_statistics_snapshot( std::size_t samples)
+{
+    stack_statistics s;
+    s.allocations = allocations;
+    s.deallocations = deallocations;
+    s.live = live;
+    s.peak_live = peak_live;
+    s.reserved = reserved;
+    s.peak_reserved = peak_reserved;
+    s.pool_hits = pool_hits;
+    s.pool_misses = pool_misses;
+    s.mappings = mapped;
+    s.resident = 0;
+
+    // the registered ranges are sampled evenly
+    mutex_guard lk( & mappings_mtx);
+    const std::size_t count( mappings().size() );
+    if ( 0 == count || 0 == samples) return s;
+    const std::size_t stride( ( count + samples - 1) / samples);
+    std::size_t sampled = 0, total = 0, resident = 0, i = 0;
+    for ( std::map< char *, std::size_t >::const_iterator it( mappings().begin() );
+          it != mappings().end(); ++it, ++i)
+    {
+        total += it->second;
+        if ( 0 != i % stride) continue;
+        sampled += it->second;
+        resident += resident_bytes( it->first, it->second);
+    }
+    s.resident = sampled == total
+        ? resident
+        : static_cast< std::size_t >( static_cast< double >( resident) / sampled * total);
+    return s;
+}
+
+}}}
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
@@ -27,6 +27,7 @@ extern "C" {
 #include <boost/assert.hpp>
 #include <boost/context/fcontext.hpp>
 
+#include <boost/coroutine/detail/stack_utils.hpp>
 #include <boost/coroutine/stack_context.hpp>
 
 #if !defined (SIGSTKSZ)
@@ -68,6 +69,22 @@ rlimit stacksize_limit()
     return limit;
 }
 
+int stack_map_flags()
+{
+#if defined(MAP_ANONYMOUS)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#elif defined(MAP_ANON)
+    int flags = MAP_PRIVATE | MAP_ANON;
+#else
+    int flags = MAP_PRIVATE;
+#endif
+#if defined(MAP_NORESERVE)
+    // do not reserve swap space for the whole stack
+    flags |= MAP_NORESERVE;
+#endif
+    return flags;
+}
+
 std::size_t page_count( std::size_t stacksize)
 {
     return static_cast< std::size_t >( 
@@ -102,29 +119,25 @@ standard_stack_allocator::maximum_stacksize()
     return static_cast< std::size_t >( detail::stacksize_limit().rlim_max);
 }
 
-void
-standard_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+void map_stack( stack_context & ctx, std::size_t size)
 {
-    BOOST_ASSERT( minimum_stacksize() <= size);
-    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
-
     const std::size_t pages( detail::page_count( size) + 1); // add one guard page
     const std::size_t size_( pages * detail::pagesize() );
     BOOST_ASSERT( 0 < size && 0 < size_);
 
+    // conform to POSIX.4 (POSIX.1b-1993, _POSIX_C_SOURCE=199309L)
+    // the pages of an anonymous private mapping are zero-filled and
+    // committed on first access - untouched pages of the stack do not
+    // consume physical memory
+#if defined(MAP_ANON) || defined(MAP_ANONYMOUS)
+    void * limit = ::mmap( 0, size_, PROT_READ | PROT_WRITE, stack_map_flags(), -1, 0);
+#else
     const int fd( ::open("/dev/zero", O_RDONLY) );
     BOOST_ASSERT( -1 != fd);
-    // conform to POSIX.4 (POSIX.1b-1993, _POSIX_C_SOURCE=199309L)
-    void * limit =
-# if defined(macintosh) || defined(__APPLE__) || defined(__APPLE_CC__)
-    ::mmap( 0, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
-# else
-    ::mmap( 0, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
-# endif
+    void * limit = ::mmap( 0, size_, PROT_READ | PROT_WRITE, stack_map_flags(), fd, 0);
     ::close( fd);
-    if ( ! limit) throw std::bad_alloc();
-
-    std::memset( limit, '\0', size_);
+#endif
+    if ( MAP_FAILED == limit) throw std::bad_alloc();
 
     // conforming to POSIX.1-2001
 #if defined(BOOST_DISABLE_ASSERTS)
@@ -136,6 +149,28 @@ standard_stack_allocator::allocate( stack_context & ctx, std::size_t size)
 
     ctx.size = size_;
     ctx.sp = static_cast< char * >( limit) + ctx.size;
+    name_stack_mapping( limit, ctx.size, 0);
+    record_stack_mapped( limit, ctx.size);
+}
+
+void unmap_stack( stack_context & ctx)
+{
+    BOOST_ASSERT( ctx.sp);
+
+    void * limit = static_cast< char * >( ctx.sp) - ctx.size;
+    record_stack_unmapped( limit, ctx.size);
+    // conform to POSIX.4 (POSIX.1b-1993, _POSIX_C_SOURCE=199309L)
+    ::munmap( limit, ctx.size);
+}
+
+void
+standard_stack_allocator::allocate( stack_context & ctx, std::size_t size)
+{
+    BOOST_ASSERT( minimum_stacksize() <= size);
+    BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= size) );
+
+    map_stack( ctx, size);
+    record_stack_allocated();
 }
 
 void
@@ -145,9 +180,33 @@ standard_stack_allocator::deallocate( stack_context & ctx)
     BOOST_ASSERT( minimum_stacksize() <= ctx.size);
     BOOST_ASSERT( is_stack_unbound() || ( maximum_stacksize() >= ctx.size) );
 
-    void * limit = static_cast< char * >( ctx.sp) - ctx.size;
-    // conform to POSIX.4 (POSIX.1b-1993, _POSIX_C_SOURCE=199309L)
-    ::munmap( limit, ctx.size);
+    record_stack_deallocated();
+    unmap_stack( ctx);
+}
+
+std::size_t size_class_of_request( std::size_t size)
+{
+    const std::size_t pages( page_count( size) );
+    std::size_t k = 0;
+    while ( ( std::size_t( 1) << k) < pages) ++k;
+    return k;
+}
+
+// returns size_classes if the stack does not belong to any size class
+std::size_t size_class_of_stack( stack_context const& ctx)
+{
+    if ( 0 != ctx.size % pagesize() ) return size_classes;
+    const std::size_t pages( ctx.size / pagesize() - 1); // without guard page
+    for ( std::size_t k = 0; k < size_classes; ++k)
+        if ( ( std::size_t( 1) << k) == pages) return k;
+    return size_classes;
+}
+
+bool is_poolable( std::size_t k)
+{
+    if ( size_classes <= k) return false;
+    return standard_stack_allocator::is_stack_unbound() ||
+        ( ( std::size_t( 1) << k) * pagesize() <= standard_stack_allocator::maximum_stacksize() );
 }
 
 }}}
@@ -22,6 +22,7 @@ extern "C" {
 #include <boost/context/detail/config.hpp>
 #include <boost/context/fcontext.hpp>
 
+#include <boost/coroutine/detail/stack_utils.hpp>
 #include <boost/coroutine/stack_context.hpp>
 
 # if defined(BOOST_MSVC)
@@ -116,11 +117,10 @@ standard_stack_allocator::allocate( stack_context & ctx, std::size_t size)
     const std::size_t size_ = pages * detail::pagesize();
     BOOST_ASSERT( 0 < size && 0 < size_);
 
+    // committed pages are zero-filled on first access
     void * limit = ::VirtualAlloc( 0, size_, MEM_COMMIT, PAGE_READWRITE);
     if ( ! limit) throw std::bad_alloc();
 
-    std::memset( limit, '\0', size_);
-
     DWORD old_options;
 #if defined(BOOST_DISABLE_ASSERTS)
     ::VirtualProtect(
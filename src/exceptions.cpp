@@ -22,6 +22,12 @@ public:
         case coroutine_errc::no_data:
             return std::string("Operation not permitted because coroutine "
                           "has no valid result.");
+        case coroutine_errc::stack_pool_exhausted:
+            return std::string("No stack available because all stacks "
+                          "of the pool are in use.");
+        case coroutine_errc::memory_budget_exceeded:
+            return std::string("Coroutine not created because the memory "
+                          "budget is exhausted.");
         }
         return std::string("unspecified coroutine_errc value\n");
     }
@@ -5,13 +5,17 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <cstdio>
+#include <cstring>
 
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
@@ -25,6 +29,20 @@
 
 #include <boost/coroutine/all.hpp>
 
+#if ! defined(BOOST_WINDOWS)
+extern "C" {
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+}
+#endif
+
 namespace coro = boost::coroutines;
 
 int value1 = 0;
@@ -37,6 +55,35 @@ int& value7 = value1;
 int value8 = 0;
 int value9 = 0;
 
+#if ! defined(BOOST_WINDOWS)
+// remembers the last stack allocated
+struct recording_stack_allocator : public coro::stack_allocator
+{
+    static coro::stack_context  last;
+
+    void allocate( coro::stack_context & ctx, std::size_t size)
+    {
+        coro::stack_allocator::allocate( ctx, size);
+        last = ctx;
+    }
+};
+
+coro::stack_context recording_stack_allocator::last;
+
+// number of resident pages of the upper `size` bytes of the stack
+std::size_t resident_pages( coro::stack_context const& ctx, std::size_t size)
+{
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    char * top = static_cast< char * >( ctx.sp);
+    std::vector< unsigned char > vec( size / page);
+    BOOST_CHECK_EQUAL( 0, ::mincore( top - size, size, & vec[0]) );
+    std::size_t n = 0;
+    BOOST_FOREACH( unsigned char c, vec)
+    { if ( c & 1) ++n; }
+    return n;
+}
+#endif
+
 #ifdef BOOST_COROUTINES_UNIDIRECT
 struct X : private boost::noncopyable
 {
@@ -200,6 +247,23 @@ void f19( coro::coroutine< const int* >::push_type & c, std::vector< const int *
 void f20( coro::coroutine< int >::push_type &)
 {}
 
+void f22( coro::coroutine< std::size_t >::push_type & c)
+{
+    char local = 0;
+    c( reinterpret_cast< std::size_t >( & local) );
+}
+
+void f21( coro::coroutine< int >::push_type & c)
+{
+    char buffer[8192];
+    for ( std::size_t i = 0; i < sizeof( buffer); ++i)
+        buffer[i] = static_cast< char >( i);
+    c( 1);
+    for ( std::size_t i = 0; i < sizeof( buffer); ++i)
+        if ( static_cast< char >( i) != buffer[i]) return;
+    c( 2);
+}
+
 void test_move()
 {
     {
@@ -529,6 +593,552 @@ void test_invalid_result()
     }
     BOOST_CHECK( catched);
 }
+
+// large locals in the frames around the context switch
+void f30( coro::coroutine< int >::push_type & c)
+{
+    volatile char buffer[8 * 1024];
+    for ( std::size_t i = 0; i < sizeof( buffer); ++i)
+        buffer[i] = static_cast< char >( i % 127);
+    c( 1);
+    value3 = true;
+    for ( std::size_t i = 0; i < sizeof( buffer); ++i)
+        if ( static_cast< char >( i % 127) != buffer[i]) value3 = false;
+    c( 2);
+}
+
+void test_hibernate()
+{
+#if defined(BOOST_WINDOWS)
+    coro::coroutine< int >::pull_type coro( f21);
+#else
+    coro::coroutine< int >::pull_type coro(
+        f21, coro::attributes(), recording_stack_allocator() );
+    const coro::stack_context ctx( recording_stack_allocator::last);
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+#endif
+    BOOST_CHECK_EQUAL( ( int) 1, coro.get() );
+#if ! defined(BOOST_WINDOWS)
+    // the pages of the stack (without the guard page) are released
+    BOOST_CHECK( 2 <= resident_pages( ctx, ctx.size - page) );
+#endif
+    BOOST_CHECK( coro.hibernate() );
+#if ! defined(BOOST_WINDOWS)
+    BOOST_CHECK_EQUAL( ( std::size_t)0, resident_pages( ctx, ctx.size - page) );
+#endif
+    BOOST_CHECK( coro.hibernate() );
+    coro();
+    BOOST_CHECK( coro);
+    BOOST_CHECK_EQUAL( ( int) 2, coro.get() );
+
+    // unwound after restoring the stack
+    value1 = 0;
+    {
+        coro::coroutine< void >::push_type coro( f12);
+        coro();
+        BOOST_CHECK_EQUAL( ( int) 7, value1);
+        BOOST_CHECK( coro.hibernate() );
+    }
+    BOOST_CHECK_EQUAL( ( int) 0, value1);
+
+    // the locals next to the switch (inlined with BOOST_COROUTINES_INLINE_JUMP)
+    // survive the hibernation
+    value3 = false;
+    {
+        coro::coroutine< int >::pull_type coro( f30);
+        BOOST_CHECK( coro.hibernate() );
+        coro();
+        BOOST_CHECK_EQUAL( ( int) 2, coro.get() );
+        BOOST_CHECK( value3);
+    }
+}
+
+struct copy_counter
+{
+    static int  copies;
+
+    copy_counter()
+    {}
+
+    copy_counter( copy_counter const&)
+    { ++copies; }
+
+    copy_counter & operator=( copy_counter const&)
+    {
+        ++copies;
+        return * this;
+    }
+};
+
+int copy_counter::copies = 0;
+
+void f27( coro::coroutine< copy_counter >::push_type & c)
+{
+    copy_counter x;
+    c( x);
+    c( x);
+}
+
+void f28( coro::coroutine< copy_counter >::pull_type & c)
+{
+    value1 = copy_counter::copies;
+    c();
+    value9 = copy_counter::copies;
+}
+
+void test_transfer()
+{
+    // the value is copied once, from the object of the producer into the
+    // consumer
+    copy_counter::copies = 0;
+    coro::coroutine< copy_counter >::pull_type source( f27);
+    BOOST_CHECK_EQUAL( 1, copy_counter::copies);
+    source();
+    BOOST_CHECK_EQUAL( 2, copy_counter::copies);
+
+    copy_counter x;
+    copy_counter::copies = 0;
+    value1 = value9 = -1;
+    coro::coroutine< copy_counter >::push_type sink( f28);
+    sink( x);
+    BOOST_CHECK_EQUAL( 1, value1);
+    sink( x);
+    BOOST_CHECK_EQUAL( 2, value9);
+}
+
+#if ! defined(BOOST_WINDOWS)
+void test_shared_stack()
+{
+    // more coroutines than shared stacks - stacks are copied in and out
+    std::vector< coro::coroutine< int >::pull_type * > coros;
+    for ( int i = 0; i < 10; ++i)
+        coros.push_back(
+            new coro::coroutine< int >::pull_type(
+                f16, coro::attributes( coro::stack_shared) ) );
+    for ( int x = 1; x <= 5; ++x)
+    {
+        BOOST_FOREACH( coro::coroutine< int >::pull_type * coro, coros)
+        {
+            BOOST_CHECK( * coro);
+            BOOST_CHECK_EQUAL( x, coro->get() );
+            ( * coro)();
+        }
+    }
+    BOOST_FOREACH( coro::coroutine< int >::pull_type * coro, coros)
+    {
+        BOOST_CHECK( ! * coro);
+        delete coro;
+    }
+
+    value1 = 0;
+    {
+        coro::coroutine< void >::push_type coro( f12, coro::attributes( coro::stack_shared) );
+        coro::coroutine< void >::push_type other( f12, coro::attributes( coro::stack_shared) );
+        coro();
+        other();
+        BOOST_CHECK_EQUAL( ( int) 7, value1);
+    }
+    BOOST_CHECK_EQUAL( ( int) 0, value1);
+}
+
+std::vector< coro::coroutine< int >::pull_type * > generators;
+
+void f29( coro::coroutine< void >::push_type & c)
+{
+    int sum = 0;
+    BOOST_FOREACH( coro::coroutine< int >::pull_type * gen, generators)
+    {
+        ( * gen)();
+        sum += gen->get();
+    }
+    c();
+    BOOST_FOREACH( coro::coroutine< int >::pull_type * gen, generators)
+    {
+        ( * gen)();
+        sum += gen->get();
+    }
+    value1 = sum;
+}
+
+void test_shared_stack_resume()
+{
+    // more generators than shared stacks - every stack runs at least one
+    for ( int i = 0; i < 2 * BOOST_COROUTINES_SHARED_STACKS; ++i)
+        generators.push_back(
+            new coro::coroutine< int >::pull_type(
+                f16, coro::attributes( coro::stack_shared) ) );
+
+    // resumed alternately by a coroutine and by the thread
+    value1 = 0;
+    coro::coroutine< void >::pull_type consumer( f29);
+    BOOST_FOREACH( coro::coroutine< int >::pull_type * gen, generators)
+    {
+        BOOST_CHECK_EQUAL( ( int) 2, gen->get() );
+        ( * gen)();
+    }
+    consumer();
+    BOOST_CHECK( ! consumer);
+    BOOST_CHECK_EQUAL( ( int) ( 2 + 4) * ( int) generators.size(), value1);
+
+    BOOST_FOREACH( coro::coroutine< int >::pull_type * gen, generators)
+    {
+        BOOST_CHECK_EQUAL( ( int) 4, gen->get() );
+        delete gen;
+    }
+    generators.clear();
+}
+
+void test_prefault()
+{
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    const std::size_t size = 16 * page;
+    recording_stack_allocator alloc;
+
+    coro::coroutine< int >::pull_type lazy(
+        f20, coro::attributes( size, coro::stack_lazy), alloc);
+    BOOST_CHECK( 16 > resident_pages( recording_stack_allocator::last, size) );
+
+    coro::coroutine< int >::pull_type prefaulted(
+        f20, coro::attributes( size, coro::stack_prefaulted), alloc);
+    BOOST_CHECK_EQUAL( ( std::size_t)16, resident_pages( recording_stack_allocator::last, size) );
+}
+
+bool maps_contain( char const* name)
+{
+    bool found = false;
+#if defined(__linux__)
+    std::FILE * f = std::fopen( "/proc/self/maps", "r");
+    if ( ! f) return false;
+    char line[512];
+    while ( ! found && std::fgets( line, sizeof( line), f) )
+        found = 0 != std::strstr( line, name);
+    std::fclose( f);
+#endif
+    return found;
+}
+
+void test_label_stack()
+{
+    coro::stack_context ctx;
+    coro::stack_allocator alloc;
+    alloc.allocate( ctx, coro::stack_allocator::default_stacksize() );
+    // naming mappings requires Linux 5.17
+    const bool named = maps_contain( "[anon:coro-stack]");
+
+    coro::attributes attr;
+    attr.label = "test[label]";
+    {
+        coro::coroutine< int >::pull_type coro( f20, attr);
+        if ( named) BOOST_CHECK( maps_contain( "[anon:coro-stack:test_label_]") );
+    }
+    BOOST_CHECK( ! maps_contain( "[anon:coro-stack:test_label_]") );
+    {
+        // the slab is not split
+        coro::slab_stack_allocator slab;
+        coro::coroutine< int >::pull_type coro( f20, attr, slab);
+        BOOST_CHECK( ! maps_contain( "[anon:coro-stack:test_label_]") );
+    }
+    alloc.deallocate( ctx);
+}
+
+volatile bool budgeted_created = false;
+
+void * create_budgeted_coroutine( void *)
+{
+    coro::coroutine< void >::pull_type coro( f1, coro::attributes( coro::budget_wait) );
+    budgeted_created = true;
+    return 0;
+}
+
+void test_memory_budget()
+{
+    typedef coro::coroutine< void >::pull_type coro_t;
+
+    const std::size_t before = coro::memory_budget::used();
+    pthread_t tid;
+    {
+        coro_t coro( f1);
+        // the stack and the control block are charged
+        BOOST_CHECK( before + coro::stack_allocator::default_stacksize() < coro::memory_budget::used() );
+        coro::memory_budget::limit( coro::memory_budget::used() + 1024);
+
+        bool thrown = false;
+        try
+        { coro_t other( f1); }
+        catch ( coro::memory_budget_exceeded const&)
+        { thrown = true; }
+        BOOST_CHECK( thrown);
+
+        // waits until `coro` is destroyed
+        budgeted_created = false;
+        BOOST_CHECK_EQUAL( 0, ::pthread_create( & tid, 0, create_budgeted_coroutine, 0) );
+        while ( 0 == coro::memory_budget::waiting() )
+            ::sched_yield();
+        BOOST_CHECK( ! budgeted_created);
+    }
+    ::pthread_join( tid, 0);
+    BOOST_CHECK( budgeted_created);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::memory_budget::waiting() );
+    coro::memory_budget::limit( 0);
+    BOOST_CHECK_EQUAL( before, coro::memory_budget::used() );
+}
+
+int recurse( int n)
+{
+    volatile char buffer[512];
+    buffer[0] = static_cast< char >( n);
+    return 0 > n ? 0 : recurse( n + 1) + buffer[0];
+}
+
+void f23( coro::coroutine< void >::push_type &)
+{ recurse( 0); }
+
+void test_overflow_diagnostics()
+{
+    int fds[2];
+    BOOST_CHECK_EQUAL( 0, ::pipe( fds) );
+    pid_t pid = ::fork();
+    if ( 0 == pid)
+    {
+        ::signal( SIGSEGV, SIG_DFL);
+        ::signal( SIGBUS, SIG_DFL);
+        coro::overflow_diagnostics::enable( fds[1]);
+        coro::attributes attr( coro::stack_allocator::minimum_stacksize() );
+        attr.label = "overflowing";
+        coro::coroutine< void >::pull_type coro( f23, attr);
+        ::_exit( 0);
+    }
+    ::close( fds[1]);
+    int status = 0;
+    ::waitpid( pid, & status, 0);
+    BOOST_CHECK( WIFSIGNALED( status) );
+
+    std::string report;
+    char buffer[256];
+    ssize_t n;
+    while ( 0 < ( n = ::read( fds[0], buffer, sizeof( buffer) ) ) )
+        report.append( buffer, n);
+    ::close( fds[0]);
+    BOOST_CHECK( std::string::npos != report.find( "stack overflow of coroutine 'overflowing'") );
+    BOOST_CHECK( std::string::npos != report.find( "created for ") );
+    std::ostringstream size;
+    size << "attributes::size " << coro::stack_allocator::minimum_stacksize();
+    BOOST_CHECK( std::string::npos != report.find( size.str() ) );
+}
+
+std::size_t counted_allocations = 0;
+
+// counts the control blocks allocated
+template< typename T >
+struct counting_allocator : public std::allocator< T >
+{
+    template< typename U >
+    struct rebind
+    { typedef counting_allocator< U > other; };
+
+    counting_allocator()
+    {}
+
+    template< typename U >
+    counting_allocator( counting_allocator< U > const&)
+    {}
+
+    T * allocate( std::size_t n)
+    {
+        ++counted_allocations;
+        return std::allocator< T >::allocate( n);
+    }
+};
+
+// remembers in its state which stack it allocated
+struct stateful_stack_allocator : public coro::stack_allocator
+{
+    static void * deallocated;
+
+    void    *   allocated;
+
+    stateful_stack_allocator() :
+        allocated( 0)
+    {}
+
+    void allocate( coro::stack_context & ctx, std::size_t size)
+    {
+        coro::stack_allocator::allocate( ctx, size);
+        allocated = ctx.sp;
+    }
+
+    void deallocate( coro::stack_context & ctx)
+    {
+        deallocated = allocated;
+        coro::stack_allocator::deallocate( ctx);
+    }
+};
+
+void * stateful_stack_allocator::deallocated = 0;
+
+void * frame_address = 0;
+
+void f25( coro::coroutine< int >::push_type & c)
+{
+    int i = 1;
+    frame_address = & i;
+    c( i);
+    c( ++i);
+}
+
+void f26( coro::coroutine< void >::push_type &)
+{ throw std::runtime_error("f26"); }
+
+// creates a coroutine with its control block on its stack whenever copied
+struct nesting_fn
+{
+    nesting_fn()
+    {}
+
+    nesting_fn( nesting_fn const&)
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( coro::control_on_stack) );
+        value1 += coro.get();
+    }
+
+    void operator()( coro::coroutine< int >::push_type & c)
+    { c( 3); }
+};
+
+void test_control_on_stack()
+{
+    typedef coro::coroutine< int >::pull_type coro_t;
+    typedef counting_allocator< coro_t > allocator_t;
+
+    const std::size_t before = coro::memory_budget::used();
+    counted_allocations = 0;
+    {
+        coro_t coro( f25, coro::attributes(), recording_stack_allocator(), allocator_t() );
+    }
+    // the caller side of the coroutine-function lives on the stack of the coroutine
+    BOOST_CHECK_EQUAL( ( std::size_t)1, counted_allocations);
+
+    counted_allocations = 0;
+    {
+        coro_t coro( f25, coro::attributes( coro::control_on_stack),
+                     recording_stack_allocator(), allocator_t() );
+        // the control block is not allocated by the allocator
+        BOOST_CHECK_EQUAL( ( std::size_t)0, counted_allocations);
+        // the coroutine runs below its control block
+        char * top = static_cast< char * >( recording_stack_allocator::last.sp);
+        BOOST_CHECK( top - recording_stack_allocator::last.size < frame_address);
+        BOOST_CHECK( frame_address < static_cast< void * >( top) );
+        BOOST_CHECK_EQUAL( ( int)1, coro.get() );
+        coro();
+        BOOST_CHECK_EQUAL( ( int)2, coro.get() );
+        BOOST_CHECK( before < coro::memory_budget::used() );
+    }
+    BOOST_CHECK_EQUAL( before, coro::memory_budget::used() );
+
+    // the stack is deallocated through the instance that allocated it
+    stateful_stack_allocator::deallocated = 0;
+    {
+        coro_t coro( f25, coro::attributes( coro::control_on_stack),
+                     stateful_stack_allocator() );
+        BOOST_CHECK_EQUAL( ( int)1, coro.get() );
+    }
+    BOOST_CHECK( 0 != stateful_stack_allocator::deallocated);
+
+    {
+        coro::attributes attr( coro::control_on_stack);
+        attr.color_stack = coro::stack_colored;
+        attr.prefault = coro::stack_prefaulted;
+        attr.label = "control-on-stack";
+        coro_t coro( f25, attr);
+        BOOST_CHECK_EQUAL( ( int)1, coro.get() );
+        coro();
+        BOOST_CHECK_EQUAL( ( int)2, coro.get() );
+        coro();
+        BOOST_CHECK( ! coro);
+    }
+
+    // the stack is released if the constructor throws
+    bool thrown = false;
+    try
+    { coro::coroutine< void >::pull_type coro( f26, coro::attributes( coro::control_on_stack) ); }
+    catch ( std::runtime_error const&)
+    { thrown = true; }
+    BOOST_CHECK( thrown);
+    BOOST_CHECK_EQUAL( before, coro::memory_budget::used() );
+
+    // the coroutine-function is copied after the control block was placed on
+    // the stack - coroutines created meanwhile get stacks of their own
+    value1 = 0;
+    {
+        nesting_fn fn;
+        coro_t coro( fn, coro::attributes( coro::control_on_stack) );
+        BOOST_CHECK( 0 < value1);
+        BOOST_CHECK_EQUAL( ( int)3, coro.get() );
+    }
+    BOOST_CHECK_EQUAL( before, coro::memory_budget::used() );
+}
+
+
+#if defined(BOOST_USE_SEGMENTED_STACKS)
+std::size_t deep( std::size_t n)
+{
+    volatile char buffer[1024];
+    buffer[0] = 1;
+    if ( 0 == n) return 0;
+    // the frame is in use after the call
+    const std::size_t depth = deep( n - 1);
+    return depth + buffer[0];
+}
+
+void f24( coro::coroutine< std::size_t >::push_type & c)
+{
+    c( deep( 10));
+    // the stack grows far beyond its initial size
+    c( deep( 4096) );
+}
+
+void test_segmented_stack()
+{
+    coro::coroutine< std::size_t >::pull_type coro( f24,
+        coro::attributes( coro::stack_allocator::minimum_stacksize() ) );
+    BOOST_CHECK_EQUAL( ( std::size_t)10, coro.get() );
+    coro();
+    BOOST_CHECK_EQUAL( ( std::size_t)4096, coro.get() );
+
+    // stack_shared is ignored - the coroutine gets a segmented stack
+    coro::attributes attr( coro::stack_allocator::minimum_stacksize() );
+    attr.share_stack = coro::stack_shared;
+    coro::coroutine< std::size_t >::pull_type shared( f24, attr);
+    BOOST_CHECK_EQUAL( ( std::size_t)10, shared.get() );
+    shared();
+    BOOST_CHECK_EQUAL( ( std::size_t)4096, shared.get() );
+}
+#endif
+
+void test_color_stack()
+{
+    typedef coro::coroutine< std::size_t >::pull_type coro_t;
+
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    std::vector< coro_t * > coros;
+    std::vector< std::size_t > uncolored, colored;
+    for ( int i = 0; i < 8; ++i)
+    {
+        coros.push_back( new coro_t( f22, coro::attributes( coro::stack_uncolored) ) );
+        uncolored.push_back( coros.back()->get() % page);
+        coros.push_back( new coro_t( f22, coro::attributes( coro::stack_colored) ) );
+        colored.push_back( coros.back()->get() % page);
+    }
+    BOOST_FOREACH( coro_t * c, coros)
+    { delete c; }
+
+    // the top frames of uncolored stacks are at the same offset in a page
+    BOOST_CHECK( uncolored.end() == std::adjacent_find(
+        uncolored.begin(), uncolored.end(), std::not_equal_to< std::size_t >() ) );
+    std::sort( colored.begin(), colored.end() );
+    BOOST_CHECK( 2 < std::unique( colored.begin(), colored.end() ) - colored.begin() );
+}
+#endif
 #else
 typedef coro::coroutine< void() > coro_void_void;
 typedef coro::coroutine< int() > coro_int_void;
@@ -1038,6 +1648,708 @@ void test_post()
     coro( -1);
     BOOST_CHECK( ! coro);
 }
+
+#if ! defined(BOOST_WINDOWS)
+void test_shared_stack()
+{
+    // more coroutines than shared stacks - stacks are copied in and out
+    std::vector< coro_int_void * > coros;
+    for ( int i = 0; i < 10; ++i)
+        coros.push_back( new coro_int_void( f16, coro::attributes( coro::stack_shared) ) );
+    for ( int x = 1; x <= 5; ++x)
+    {
+        BOOST_FOREACH( coro_int_void * coro, coros)
+        {
+            BOOST_CHECK( * coro);
+            BOOST_CHECK_EQUAL( x, coro->get() );
+            ( * coro)();
+        }
+    }
+    BOOST_FOREACH( coro_int_void * coro, coros)
+    {
+        BOOST_CHECK( ! * coro);
+        delete coro;
+    }
+
+    value1 = 0;
+    {
+        coro_int coro( f12, coro_int::arguments( 3, 7), coro::attributes( coro::stack_shared) );
+        coro_int other( f12, coro_int::arguments( 3, 7), coro::attributes( coro::stack_shared) );
+        BOOST_CHECK_EQUAL( ( int) 7, value1);
+        BOOST_CHECK_EQUAL( ( int) 10, coro.get() );
+        BOOST_CHECK_EQUAL( ( int) 10, other.get() );
+    }
+    BOOST_CHECK_EQUAL( ( int) 0, value1);
+}
+#endif
+#endif
+
+#if ! defined(BOOST_WINDOWS)
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+// the last coroutine running f25 runs on the stack `ctx`
+bool runs_on( coro::stack_context const& ctx)
+{
+    char * top = static_cast< char * >( ctx.sp);
+    return top - ctx.size < frame_address && frame_address < static_cast< void * >( top);
+}
+
+// recurses until at most `margin` bytes of the `size` bytes below `entry` are
+// left, returns the bytes used
+std::size_t fill_stack( char const* entry, std::size_t size, std::size_t margin)
+{
+    volatile char buffer[1024];
+    buffer[0] = 0;
+    const std::size_t used( entry - const_cast< char const* >( & buffer[0]) );
+    if ( used + margin >= size) return used;
+    // the frame is in use after the call
+    return fill_stack( entry, size, margin) + buffer[0];
+}
+
+void f31( coro::coroutine< std::size_t >::push_type & c, std::size_t size)
+{
+    char entry = 0;
+    c( fill_stack( & entry, size, 8 * 1024) );
+}
+
+// a coroutine with a stack of `size` bytes allocated by `alloc` uses `n` bytes
+// of it except the last 8KB; returns the bytes used
+template< typename StackAllocator >
+std::size_t fill_coroutine_stack( StackAllocator const& alloc, std::size_t size, std::size_t n)
+{
+    coro::coroutine< std::size_t >::pull_type coro(
+        boost::bind( f31, _1, n), coro::attributes( size), alloc);
+    BOOST_CHECK( coro);
+    return coro.get();
+}
+
+void f34( coro::coroutine< std::size_t >::push_type & c, std::size_t size)
+{
+    c( 0);
+    char entry = 0;
+    c( fill_stack( & entry, size, 8 * 1024) );
+}
+
+void * resume_coroutine( void * vp)
+{
+    ( * static_cast< coro::coroutine< std::size_t >::pull_type * >( vp) )();
+    return 0;
+}
+#endif
+
+void test_pooled_stack_allocator()
+{
+    std::size_t size = coro::pooled_stack_allocator::default_stacksize();
+    coro::pooled_stack_allocator alloc( 2);
+    coro::pooled_stack_allocator::purge();
+
+    coro::stack_context ctx1;
+    alloc.allocate( ctx1, size);
+    BOOST_CHECK( 0 != ctx1.sp);
+    BOOST_CHECK( size <= ctx1.size);
+    void * sp = ctx1.sp;
+    alloc.deallocate( ctx1);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::pooled_stack_allocator::cached() );
+
+    // deallocated stack is handed out again
+    coro::stack_context ctx2;
+    alloc.allocate( ctx2, size);
+    BOOST_CHECK_EQUAL( sp, ctx2.sp);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::pooled_stack_allocator::cached() );
+
+    // prewarm does not exceed max_cached()
+    alloc.prewarm( size, 4);
+    BOOST_CHECK_EQUAL( alloc.max_cached(), coro::pooled_stack_allocator::cached() );
+    coro::stack_context ctx3, ctx4, ctx5;
+    alloc.allocate( ctx3, size);
+    alloc.allocate( ctx4, size);
+    alloc.allocate( ctx5, size);
+    BOOST_CHECK( ctx3.sp != ctx2.sp);
+    BOOST_CHECK( ctx4.sp != ctx3.sp);
+    BOOST_CHECK( ctx5.sp != ctx4.sp);
+
+    alloc.deallocate( ctx5);
+    alloc.deallocate( ctx4);
+    alloc.deallocate( ctx3);
+    alloc.deallocate( ctx2);
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine takes its stack from the pool and returns it
+    coro::pooled_stack_allocator::purge();
+    alloc.allocate( ctx1, size);
+    alloc.deallocate( ctx1);
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( size), alloc);
+        BOOST_CHECK( runs_on( ctx1) );
+        BOOST_CHECK_EQUAL( ( std::size_t)0, coro::pooled_stack_allocator::cached() );
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::pooled_stack_allocator::cached() );
+#endif
+    coro::pooled_stack_allocator::purge();
+}
+
+void test_lazy_stack_commit()
+{
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    const std::size_t size = 64 * page;
+    coro::stack_allocator alloc;
+
+    // no page of a new stack is committed
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, resident_pages( ctx, size) );
+
+    // only the pages touched are committed
+    std::memset( static_cast< char * >( ctx.sp) - 2 * page, 0, 2 * page);
+    BOOST_CHECK_EQUAL( ( std::size_t)2, resident_pages( ctx, size) );
+    alloc.deallocate( ctx);
+}
+
+void test_slab_stack_allocator()
+{
+    std::size_t size = coro::slab_stack_allocator::default_stacksize();
+    coro::slab_stack_allocator alloc( 2);
+
+    coro::stack_context ctx1, ctx2;
+    alloc.allocate( ctx1, size);
+    alloc.allocate( ctx2, size);
+    BOOST_CHECK( size <= ctx1.size);
+    BOOST_CHECK_EQUAL( ctx1.size, ctx2.size);
+    BOOST_CHECK( ctx1.sp != ctx2.sp);
+
+    // stacks are usable
+    std::memset( static_cast< char * >( ctx2.sp) - 64, 0xff, 64);
+
+    // the slot of a deallocated stack is reused
+    void * sp = ctx2.sp;
+    alloc.deallocate( ctx2);
+    coro::stack_context ctx3;
+    alloc.allocate( ctx3, size);
+    BOOST_CHECK_EQUAL( sp, ctx3.sp);
+
+    // slab is full, next stack comes from a new slab
+    coro::stack_context ctx4;
+    alloc.allocate( ctx4, size);
+    BOOST_CHECK( ctx4.sp != ctx1.sp);
+    BOOST_CHECK( ctx4.sp != ctx3.sp);
+
+    alloc.deallocate( ctx4);
+    alloc.deallocate( ctx3);
+    alloc.deallocate( ctx1);
+
+    // guard_auto never splits a slab at each stack
+    BOOST_CHECK_EQUAL(
+        coro::slab_stack_allocator::lightweight_guards() ? coro::guard_per_stack : coro::guard_per_slab,
+        alloc.guard() );
+    coro::slab_stack_allocator unguarded( 2, coro::guard_none);
+    BOOST_CHECK_EQUAL( coro::guard_none, unguarded.guard() );
+    unguarded.allocate( ctx1, size);
+    // the guard page is accessible
+    std::memset( static_cast< char * >( ctx1.sp) - ctx1.size, 0xff, 64);
+    unguarded.deallocate( ctx1);
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine runs on the slot of a deallocated stack, its slot is
+    // reused after the coroutine was destroyed
+    alloc.allocate( ctx1, size);
+    alloc.allocate( ctx2, size);
+    alloc.deallocate( ctx2);
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( size), alloc);
+        BOOST_CHECK( runs_on( ctx2) );
+    }
+    alloc.allocate( ctx3, size);
+    BOOST_CHECK_EQUAL( ctx2.sp, ctx3.sp);
+    alloc.deallocate( ctx3);
+    alloc.deallocate( ctx1);
+#endif
+}
+
+void test_hugepage_stack_allocator()
+{
+    std::size_t size = coro::hugepage_stack_allocator::default_stacksize();
+    coro::hugepage_stack_allocator alloc;
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK( size <= ctx.size);
+    BOOST_CHECK_EQUAL( ( std::size_t)0,
+        reinterpret_cast< std::size_t >( ctx.sp) % coro::hugepage_stack_allocator::hugepagesize() );
+    // falls back if huge pages are not available
+    coro::hugepage_stack_allocator::backing_t b = coro::hugepage_stack_allocator::backing( ctx);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::hugepage_stack_allocator::stacks( b) );
+
+    // stack is usable
+    std::memset( static_cast< char * >( ctx.sp) - 4096, 0xff, 4096);
+
+    alloc.deallocate( ctx);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::hugepage_stack_allocator::stacks( b) );
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // the stack of a coroutine is backed like the stack above
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( size), alloc);
+        BOOST_CHECK_EQUAL( ( std::size_t)1, coro::hugepage_stack_allocator::stacks( b) );
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::hugepage_stack_allocator::stacks( b) );
+#endif
+}
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+void f32( coro::coroutine< void >::push_type &)
+{}
+
+void f33( coro::coroutine< void >::push_type &)
+{
+    volatile char buffer[16 * 1024];
+    for ( std::size_t i = 0; i < sizeof( buffer); ++i) buffer[i] = 0;
+}
+#endif
+void test_growable_stack_allocator()
+{
+    std::size_t size = coro::growable_stack_allocator::minimum_stacksize();
+    coro::growable_stack_allocator alloc( 1024 * 1024);
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK( 1024 * 1024 <= ctx.size);
+    std::size_t committed = coro::growable_stack_allocator::committed( ctx);
+    BOOST_CHECK( size <= committed);
+    BOOST_CHECK( committed < ctx.size);
+
+    // accessing the stack below the committed part grows it
+    std::memset( static_cast< char * >( ctx.sp) - 256 * 1024, 0xff, 256 * 1024);
+    BOOST_CHECK( 256 * 1024 <= coro::growable_stack_allocator::committed( ctx) );
+
+    alloc.deallocate( ctx);
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine recursing beyond the committed part of its stack
+    BOOST_CHECK( 512 * 1024 - 8 * 1024 <= fill_coroutine_stack( alloc, size, 512 * 1024) );
+
+    // grows its stack while resumed by a thread without an alternate signal
+    // stack (prepare_thread() not called)
+    coro::coroutine< std::size_t >::pull_type coro(
+        boost::bind( f34, _1, 512 * 1024), coro::attributes( size), alloc);
+    pthread_t tid;
+    BOOST_CHECK_EQUAL( 0, ::pthread_create( & tid, 0, resume_coroutine, & coro) );
+    ::pthread_join( tid, 0);
+    BOOST_CHECK( 512 * 1024 - 8 * 1024 <= coro.get() );
+#endif
+}
+
+// NUMA policy of the page at `addr` (MPOL_* of <numaif.h>), -1 if unknown
+int memory_policy( void * addr)
+{
+    int mode = -1;
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    const int mpol_f_addr = 2;
+    if ( 0 != ::syscall( SYS_get_mempolicy, & mode, 0, 0, addr, mpol_f_addr) ) return -1;
+#else
+    ( void) addr;
+#endif
+    return mode;
+}
+
+void test_numa_stack_allocator()
+{
+    BOOST_CHECK( 1 <= coro::numa_stack_allocator::nodes() );
+    const std::size_t node = coro::numa_stack_allocator::current_node();
+    BOOST_CHECK( node < coro::numa_stack_allocator::nodes() );
+
+    std::size_t size = coro::numa_stack_allocator::default_stacksize();
+    coro::numa_stack_allocator alloc( 1);
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK( size <= ctx.size);
+    BOOST_CHECK_EQUAL( node, coro::numa_stack_allocator::node_of( ctx) );
+    std::memset( static_cast< char * >( ctx.sp) - 4096, 0xff, 4096);
+
+    // deallocated stack is cached for its node and handed out again
+    void * sp = ctx.sp;
+    alloc.deallocate( ctx);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::numa_stack_allocator::cached( node) );
+    alloc.allocate( ctx, size);
+    BOOST_CHECK_EQUAL( sp, ctx.sp);
+
+    // the node is preferred unless strict binding is requested - a cached
+    // stack is bound again for an allocator with the other policy
+    const int mpol_preferred = 1, mpol_bind = 2;
+    void * addr = static_cast< char * >( ctx.sp) - 4096;
+    const bool policies( -1 != memory_policy( addr) );
+    if ( policies)
+        BOOST_CHECK_EQUAL( mpol_preferred, memory_policy( addr) );
+    alloc.deallocate( ctx);
+    coro::numa_stack_allocator strict( 1, coro::numa_bound);
+    BOOST_CHECK_EQUAL( coro::numa_bound, strict.policy() );
+    strict.allocate( ctx, size);
+    BOOST_CHECK_EQUAL( sp, ctx.sp);
+    if ( policies)
+        BOOST_CHECK_EQUAL( mpol_bind, memory_policy( addr) );
+    strict.deallocate( ctx);
+    alloc.allocate( ctx, size);
+    if ( policies)
+        BOOST_CHECK_EQUAL( mpol_preferred, memory_policy( addr) );
+    alloc.deallocate( ctx);
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine runs on the stack cached for the node, its control block
+    // is bound to the node too
+    {
+        typedef coro::coroutine< int >::pull_type coro_t;
+        coro_t coro( f25, coro::attributes( size), alloc,
+                     coro::numa_allocator< coro_t >() );
+        BOOST_CHECK( runs_on( ctx) );
+        BOOST_CHECK_EQUAL( ( std::size_t)0, coro::numa_stack_allocator::cached( node) );
+        if ( policies)
+            BOOST_CHECK_EQUAL( mpol_preferred, memory_policy( frame_address) );
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::numa_stack_allocator::cached( node) );
+#endif
+
+    coro::numa_stack_allocator::purge();
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::numa_stack_allocator::cached( node) );
+
+    // control blocks
+    coro::numa_allocator< int > ialloc;
+    int * p = ialloc.allocate( 10);
+    std::memset( p, 0xff, 10 * sizeof( int) );
+    ialloc.deallocate( p, 10);
+    BOOST_CHECK_EQUAL( p, ialloc.allocate( 10) );
+    ialloc.deallocate( p, 10);
+
+    std::vector< std::string, coro::numa_allocator< std::string > > vec( 1000, "abc");
+    BOOST_CHECK_EQUAL( std::string( "abc"), vec.back() );
+}
+
+void * deallocate_stacks( void * vp)
+{
+    std::vector< coro::stack_context > * stacks = static_cast< std::vector< coro::stack_context > * >( vp);
+    coro::magazine_stack_allocator alloc;
+    BOOST_FOREACH( coro::stack_context & ctx, * stacks)
+    { alloc.deallocate( ctx); }
+    return 0;
+}
+
+void test_magazine_stack_allocator()
+{
+    std::size_t size = coro::magazine_stack_allocator::default_stacksize();
+    coro::magazine_stack_allocator alloc;
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::magazine_stack_allocator::cached() );
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK( size <= ctx.size);
+    void * sp = ctx.sp;
+    alloc.deallocate( ctx);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, coro::magazine_stack_allocator::cached() );
+    alloc.allocate( ctx, size);
+    BOOST_CHECK_EQUAL( sp, ctx.sp);
+    alloc.deallocate( ctx);
+    coro::magazine_stack_allocator::purge();
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::magazine_stack_allocator::cached() );
+
+    // stacks deallocated by another thread reach this thread via the depot
+    const std::size_t n = 5 * BOOST_COROUTINES_MAGAZINE_SIZE;
+    std::vector< coro::stack_context > stacks( n);
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.allocate( c, size); }
+    pthread_t tid;
+    BOOST_CHECK_EQUAL( 0, ::pthread_create( & tid, 0, deallocate_stacks, & stacks) );
+    ::pthread_join( tid, 0);
+    BOOST_CHECK_EQUAL( n, coro::magazine_stack_allocator::cached() );
+
+    coro::stack_statistics before = coro::stack_statistics::snapshot( 0);
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.allocate( c, size); }
+    BOOST_CHECK_EQUAL( before.pool_hits + n, coro::stack_statistics::snapshot( 0).pool_hits);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::magazine_stack_allocator::cached() );
+
+    // trim() releases the magazines of the depot, purge() those of the thread
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.deallocate( c); }
+    BOOST_CHECK_EQUAL( n, coro::magazine_stack_allocator::cached() );
+    coro::magazine_stack_allocator::trim();
+    BOOST_CHECK( 2 * BOOST_COROUTINES_MAGAZINE_SIZE >= coro::magazine_stack_allocator::cached() );
+    coro::magazine_stack_allocator::purge();
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::magazine_stack_allocator::cached() );
+
+    // stacks beyond the bound are deallocated
+    coro::magazine_stack_allocator bounded( 2);
+    for ( std::size_t i = 0; i < 3; ++i)
+        bounded.allocate( stacks[i], size);
+    for ( std::size_t i = 0; i < 3; ++i)
+        bounded.deallocate( stacks[i]);
+    BOOST_CHECK_EQUAL( ( std::size_t)2, coro::magazine_stack_allocator::cached() );
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine takes the stack cached last from the magazine of the
+    // thread, the stack returns to the magazine
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( size), alloc);
+        BOOST_CHECK( runs_on( stacks[1]) );
+        BOOST_CHECK_EQUAL( ( std::size_t)1, coro::magazine_stack_allocator::cached() );
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)2, coro::magazine_stack_allocator::cached() );
+#endif
+    coro::magazine_stack_allocator::purge();
+}
+
+void test_deferred_stack_allocator()
+{
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    // a slot size no other test uses - no slab with free slots exists
+    std::size_t size = coro::deferred_stack_allocator::default_stacksize() + 3 * page;
+    coro::deferred_stack_allocator alloc;
+    coro::deferred_stack_allocator::reclaim();
+
+    // the stacks are carved out of one slab - one mapping instead of one per stack
+    std::vector< coro::stack_context > stacks( 8);
+    const std::size_t mappings = coro::stack_statistics::snapshot().mappings;
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    {
+        alloc.allocate( c, size);
+        ::memset( static_cast< char * >( c.sp) - page, 0xaa, page);
+    }
+    BOOST_CHECK( mappings + 1 >= coro::stack_statistics::snapshot().mappings);
+    std::set< void * > slots;
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    {
+        slots.insert( c.sp);
+        alloc.deallocate( c);
+    }
+    // queued stacks keep their memory until they are reclaimed
+    BOOST_CHECK_EQUAL( stacks.size(), coro::deferred_stack_allocator::pending() );
+    BOOST_CHECK_EQUAL( ( std::size_t)1, resident_pages( stacks[0], page) );
+    BOOST_CHECK_EQUAL( stacks.size(), coro::deferred_stack_allocator::reclaim() );
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::deferred_stack_allocator::pending() );
+    // nothing was unmapped - the memory is released, the slots are reused
+    BOOST_CHECK( mappings + 1 >= coro::stack_statistics::snapshot().mappings);
+    BOOST_FOREACH( coro::stack_context const& c, stacks)
+    { BOOST_CHECK_EQUAL( ( std::size_t)0, resident_pages( c, page) ); }
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    {
+        alloc.allocate( c, size);
+        BOOST_CHECK( slots.count( c.sp) );
+    }
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.deallocate( c); }
+    coro::deferred_stack_allocator::reclaim();
+
+    // deallocate() releases the stacks if a batch is complete
+    coro::deferred_stack_allocator batched( 4);
+    for ( std::size_t i = 0; i < 4; ++i)
+        batched.allocate( stacks[i], size);
+    for ( std::size_t i = 0; i < 3; ++i)
+        batched.deallocate( stacks[i]);
+    BOOST_CHECK_EQUAL( ( std::size_t)3, coro::deferred_stack_allocator::pending() );
+    batched.deallocate( stacks[3]);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::deferred_stack_allocator::pending() );
+
+    // the reaper thread releases the stacks in the background
+    coro::deferred_stack_allocator::start_reaper( 1);
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.allocate( c, size); }
+    BOOST_FOREACH( coro::stack_context & c, stacks)
+    { alloc.deallocate( c); }
+    coro::deferred_stack_allocator::flush_reaper();
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::deferred_stack_allocator::pending() );
+    coro::deferred_stack_allocator::stop_reaper();
+}
+
+void test_static_stack_pool()
+{
+    typedef coro::static_stack_pool< 2, 16 * 1024 > pool_t;
+    pool_t alloc;
+    BOOST_CHECK_EQUAL( ( std::size_t)2, pool_t::capacity() );
+    BOOST_CHECK_EQUAL( ( std::size_t)2, pool_t::available() );
+
+    coro::stack_context ctx1, ctx2, ctx3;
+    alloc.allocate( ctx1, pool_t::default_stacksize() );
+    alloc.allocate( ctx2, pool_t::default_stacksize() );
+    BOOST_CHECK( pool_t::default_stacksize() < ctx1.size);
+    BOOST_CHECK( ctx1.sp != ctx2.sp);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, pool_t::available() );
+
+    // the lowest page of each stack is a guard page
+    pid_t pid = ::fork();
+    if ( 0 == pid)
+    {
+        ::signal( SIGSEGV, SIG_DFL);
+        * ( static_cast< volatile char * >( ctx1.sp) - ctx1.size) = 0;
+        ::_exit( 0);
+    }
+    int status = 0;
+    ::waitpid( pid, & status, 0);
+    BOOST_CHECK( WIFSIGNALED( status) );
+
+    // an exhausted pool throws
+    bool thrown = false;
+    try
+    { alloc.allocate( ctx3, pool_t::default_stacksize() ); }
+    catch ( coro::stack_pool_exhausted const& e)
+    {
+        thrown = true;
+        BOOST_CHECK( coro::coroutine_category() == e.code().category() );
+        BOOST_CHECK_EQUAL( static_cast< int >( coro::coroutine_errc::stack_pool_exhausted), e.code().value() );
+    }
+    BOOST_CHECK( thrown);
+
+    void * sp = ctx2.sp;
+    alloc.deallocate( ctx2);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, pool_t::available() );
+    alloc.allocate( ctx3, pool_t::default_stacksize() );
+    BOOST_CHECK_EQUAL( sp, ctx3.sp);
+    alloc.deallocate( ctx1);
+    alloc.deallocate( ctx3);
+    BOOST_CHECK_EQUAL( ( std::size_t)2, pool_t::available() );
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // a coroutine holds a stack of the pool - creating a coroutine if the
+    // pool is exhausted throws and releases the control block
+    const std::size_t size = pool_t::default_stacksize();
+    {
+        coro::coroutine< int >::pull_type coro( f25, coro::attributes( size), alloc);
+        BOOST_CHECK_EQUAL( ( std::size_t)1, pool_t::available() );
+        alloc.allocate( ctx1, size);
+        const std::size_t used = coro::memory_budget::used();
+        thrown = false;
+        try
+        { coro::coroutine< int >::pull_type other( f25, coro::attributes( size), alloc); }
+        catch ( coro::stack_pool_exhausted const&)
+        { thrown = true; }
+        BOOST_CHECK( thrown);
+        BOOST_CHECK_EQUAL( used, coro::memory_budget::used() );
+        alloc.deallocate( ctx1);
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)2, pool_t::available() );
+#endif
+}
+
+void test_stack_statistics()
+{
+    const std::size_t page = ::sysconf( _SC_PAGESIZE);
+    std::size_t size = coro::stack_allocator::default_stacksize();
+    coro::stack_allocator alloc;
+
+    coro::stack_statistics::sample_resident( true);
+    coro::stack_statistics before = coro::stack_statistics::snapshot();
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    std::memset( static_cast< char * >( ctx.sp) - 4 * page, 0xff, 4 * page);
+
+    coro::stack_statistics s = coro::stack_statistics::snapshot( 1000);
+    BOOST_CHECK_EQUAL( before.allocations + 1, s.allocations);
+    BOOST_CHECK_EQUAL( before.live + 1, s.live);
+    BOOST_CHECK( s.live <= s.peak_live);
+    BOOST_CHECK_EQUAL( before.mappings + 1, s.mappings);
+    BOOST_CHECK_EQUAL( before.reserved + ctx.size, s.reserved);
+    BOOST_CHECK( s.reserved <= s.peak_reserved);
+    BOOST_CHECK( before.resident + 4 * page <= s.resident);
+
+    // counted, but not registered for sampling
+    coro::stack_statistics::sample_resident( false);
+    coro::stack_context unsampled;
+    alloc.allocate( unsampled, size);
+    std::memset( static_cast< char * >( unsampled.sp) - 4 * page, 0xff, 4 * page);
+    s = coro::stack_statistics::snapshot( 1000);
+    BOOST_CHECK_EQUAL( before.mappings + 2, s.mappings);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, s.resident);
+    alloc.deallocate( unsampled);
+
+    alloc.deallocate( ctx);
+    s = coro::stack_statistics::snapshot();
+    BOOST_CHECK_EQUAL( before.deallocations + 2, s.deallocations);
+    BOOST_CHECK_EQUAL( before.live, s.live);
+    BOOST_CHECK_EQUAL( before.reserved, s.reserved);
+
+    // cached stacks remain reserved
+    coro::pooled_stack_allocator pool;
+    pool.allocate( ctx, size);
+    pool.deallocate( ctx);
+    before = coro::stack_statistics::snapshot();
+    pool.allocate( ctx, size);
+    s = coro::stack_statistics::snapshot();
+    BOOST_CHECK_EQUAL( before.pool_hits + 1, s.pool_hits);
+    BOOST_CHECK_EQUAL( before.live + 1, s.live);
+    BOOST_CHECK_EQUAL( before.reserved, s.reserved);
+    BOOST_CHECK( 0 < s.pool_hit_rate() );
+    pool.deallocate( ctx);
+    coro::pooled_stack_allocator::purge();
+}
+
+void test_painted_stack_allocator()
+{
+    std::size_t size = coro::stack_allocator::default_stacksize();
+    coro::painted_stack_allocator<> alloc( "test_painted_stack_allocator");
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    BOOST_CHECK_EQUAL( ( std::size_t)0, coro::painted_stack_allocator<>::used( ctx) );
+
+    std::memset( static_cast< char * >( ctx.sp) - 1000, 0, 1000);
+    BOOST_CHECK_EQUAL( ( std::size_t)1000, coro::painted_stack_allocator<>::used( ctx) );
+
+    coro::stack_usage usage = coro::painted_stack_allocator<>::usage( "test_painted_stack_allocator");
+    BOOST_CHECK_EQUAL( ( std::size_t)1, usage.stacks);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, usage.live);
+    BOOST_CHECK_EQUAL( ( std::size_t)1000, usage.max_used);
+
+    std::memset( static_cast< char * >( ctx.sp) - 2000, 0, 2000);
+    alloc.deallocate( ctx);
+
+    usage = coro::painted_stack_allocator<>::usage( "test_painted_stack_allocator");
+    BOOST_CHECK_EQUAL( ( std::size_t)0, usage.live);
+    BOOST_CHECK_EQUAL( ( std::size_t)2000, usage.max_used);
+
+#if defined(BOOST_COROUTINES_UNIDIRECT) && ! defined(BOOST_USE_SEGMENTED_STACKS)
+    // functions of the same signature are accounted separately
+    typedef coro::painted_stack_allocator<> painted_t;
+    char const* site32 = painted_t::site( f32);
+    char const* site33 = painted_t::site( f33);
+    BOOST_CHECK( 0 != std::strcmp( site32, site33) );
+    BOOST_CHECK_EQUAL( site32, painted_t::site( & f32) );
+    {
+        coro::coroutine< void >::pull_type coro1( f32, coro::attributes(), painted_t() );
+        coro::coroutine< void >::pull_type coro2( f33, coro::attributes(), painted_t() );
+    }
+    BOOST_CHECK_EQUAL( ( std::size_t)1, painted_t::usage( site32).stacks);
+    BOOST_CHECK_EQUAL( ( std::size_t)1, painted_t::usage( site33).stacks);
+    BOOST_CHECK( painted_t::usage( site32).max_used < 16 * 1024);
+    BOOST_CHECK( painted_t::usage( site33).max_used >= 16 * 1024);
+#endif
+}
+
+void test_adaptive_stack_allocator()
+{
+    typedef coro::adaptive_stack_allocator<> allocator_t;
+
+    std::size_t size = coro::stack_allocator::default_stacksize();
+    allocator_t alloc( "test_adaptive_stack_allocator", 50);
+    BOOST_CHECK_EQUAL( size, alloc.stacksize( size) );
+
+    coro::stack_context ctx;
+    alloc.allocate( ctx, size);
+    std::memset( static_cast< char * >( ctx.sp) - 12000, 0, 12000);
+    alloc.deallocate( ctx);
+
+    std::size_t learned = alloc.stacksize( size);
+    BOOST_CHECK( learned >= 18000);
+    BOOST_CHECK( learned < size);
+    alloc.allocate( ctx, size);
+    BOOST_CHECK( ctx.size < size);
+    alloc.deallocate( ctx);
+
+    std::stringstream ss;
+    allocator_t::save( ss);
+    BOOST_CHECK( std::string::npos != ss.str().find( "12000 test_adaptive_stack_allocator\n") );
+
+    std::stringstream in( "24000 test_adaptive_stack_allocator_loaded\n");
+    allocator_t::load( in);
+    allocator_t loaded( "test_adaptive_stack_allocator_loaded", 0, false);
+    BOOST_CHECK_EQUAL( ( std::max)( allocator_t::minimum_stacksize(), ( std::size_t)24000),
+                       loaded.stacksize( size) );
+}
 #endif
 
 boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
@@ -1060,6 +2372,10 @@ boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
     test->add( BOOST_TEST_CASE( & test_post) );
 #else
     test->add( BOOST_TEST_CASE( & test_invalid_result) );
+    test->add( BOOST_TEST_CASE( & test_transfer) );
+# if ! defined(BOOST_USE_SEGMENTED_STACKS)
+    test->add( BOOST_TEST_CASE( & test_hibernate) );
+# endif
 #endif
     test->add( BOOST_TEST_CASE( & test_ref) );
     test->add( BOOST_TEST_CASE( & test_const_ref) );
@@ -1069,6 +2385,42 @@ boost::unit_test::test_suite * init_unit_test_suite( int, char* [])
     test->add( BOOST_TEST_CASE( & test_exceptions) );
     test->add( BOOST_TEST_CASE( & test_output_iterator) );
     test->add( BOOST_TEST_CASE( & test_input_iterator) );
+#if ! defined(BOOST_WINDOWS)
+# if ! defined(BOOST_USE_SEGMENTED_STACKS)
+    test->add( BOOST_TEST_CASE( & test_shared_stack) );
+#  ifdef BOOST_COROUTINES_UNIDIRECT
+    test->add( BOOST_TEST_CASE( & test_shared_stack_resume) );
+#  endif
+# endif
+# ifdef BOOST_COROUTINES_UNIDIRECT
+#  if defined(BOOST_USE_SEGMENTED_STACKS)
+    test->add( BOOST_TEST_CASE( & test_segmented_stack) );
+#  else
+    test->add( BOOST_TEST_CASE( & test_prefault) );
+    test->add( BOOST_TEST_CASE( & test_lazy_stack_commit) );
+    test->add( BOOST_TEST_CASE( & test_color_stack) );
+    test->add( BOOST_TEST_CASE( & test_label_stack) );
+    test->add( BOOST_TEST_CASE( & test_overflow_diagnostics) );
+    test->add( BOOST_TEST_CASE( & test_control_on_stack) );
+#  endif
+    test->add( BOOST_TEST_CASE( & test_memory_budget) );
+# endif
+    test->add( BOOST_TEST_CASE( & test_pooled_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_slab_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_hugepage_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_growable_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_numa_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_magazine_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_deferred_stack_allocator) );
+    test->add( BOOST_TEST_CASE( & test_static_stack_pool) );
+# if ! defined(BOOST_USE_SEGMENTED_STACKS)
+    test->add( BOOST_TEST_CASE( & test_stack_statistics) );
+# endif
+    test->add( BOOST_TEST_CASE( & test_painted_stack_allocator) );
+# if ! defined(BOOST_USE_SEGMENTED_STACKS)
+    test->add( BOOST_TEST_CASE( & test_adaptive_stack_allocator) );
+# endif
+#endif
 
     return test;
 }